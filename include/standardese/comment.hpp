@@ -22,6 +22,8 @@ class cpp_file;
 
 namespace standardese
 {
+class entity_blacklist;
+
 /// The registry of the comments for all entities.
 ///
 /// It also stores all member groups.
@@ -88,7 +90,21 @@ public:
 
     /// \effects Parses all comments in the given file.
     /// \notes This function is thread safe.
-    void parse(type_safe::object_ref<const cppast::cpp_file> file) const;
+    void parse(type_safe::object_ref<const cppast::cpp_file> file) const
+    {
+        parse_impl(file, nullptr);
+    }
+
+    /// \effects Parses all comments in the given file,
+    /// except for the ones of entities inside namespaces blacklisted by the given blacklist.
+    /// Classes in those namespaces and their members are still parsed,
+    /// as they might be injected into a derived class.
+    /// \notes This function is thread safe.
+    void parse(type_safe::object_ref<const cppast::cpp_file> file,
+               const entity_blacklist&                       blacklist) const
+    {
+        parse_impl(file, type_safe::ref(blacklist));
+    }
 
     /// \effects Finishes parsing of the comments.
     /// \returns The registry containing all registered comments.
@@ -97,6 +113,9 @@ public:
     comment_registry finish();
 
 private:
+    void parse_impl(type_safe::object_ref<const cppast::cpp_file> file,
+                    type_safe::optional_ref<const entity_blacklist>  blacklist) const;
+
     bool register_commented(type_safe::object_ref<const cppast::cpp_entity> entity,
                             comment::doc_comment comment, bool allow_cmd = true) const;
 
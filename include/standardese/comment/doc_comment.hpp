@@ -23,7 +23,7 @@ namespace comment
         {
         public:
             section_range(const std::vector<std::unique_ptr<markup::doc_section>>& sections)
-            : begin_(sections.begin()), end_(sections.end())
+            : begin_(sections.data()), end_(sections.data() + sections.size())
             {}
 
             bool empty() const noexcept
@@ -47,7 +47,8 @@ namespace comment
             }
 
         private:
-            std::vector<std::unique_ptr<markup::doc_section>>::const_iterator begin_, end_;
+            const std::unique_ptr<markup::doc_section>* begin_;
+            const std::unique_ptr<markup::doc_section>* end_;
         };
 
     public:
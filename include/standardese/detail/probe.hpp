@@ -0,0 +1,29 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_DETAIL_PROBE_HPP_INCLUDED
+#define STANDARDESE_DETAIL_PROBE_HPP_INCLUDED
+
+// USDT probes of the provider `standardese`.
+//
+// If `STANDARDESE_HAS_USDT` is set, they expand to the `sys/sdt.h` probes,
+// which are a single `nop` until a tracer like `perf` or `bpftrace` attaches to them.
+// Otherwise they expand to nothing.
+// The arguments are evaluated even if nothing is attached, so they should be cheap.
+#if defined(STANDARDESE_HAS_USDT) && STANDARDESE_HAS_USDT
+#    include <sys/sdt.h>
+
+#    define STANDARDESE_PROBE0(Name) DTRACE_PROBE(standardese, Name)
+#    define STANDARDESE_PROBE1(Name, A) DTRACE_PROBE1(standardese, Name, A)
+#    define STANDARDESE_PROBE2(Name, A, B) DTRACE_PROBE2(standardese, Name, A, B)
+#    define STANDARDESE_PROBE3(Name, A, B, C) DTRACE_PROBE3(standardese, Name, A, B, C)
+#else
+// sizeof() to prevent unused warnings without evaluating the arguments
+#    define STANDARDESE_PROBE0(Name) ((void)0)
+#    define STANDARDESE_PROBE1(Name, A) ((void)sizeof(A))
+#    define STANDARDESE_PROBE2(Name, A, B) ((void)sizeof(A), (void)sizeof(B))
+#    define STANDARDESE_PROBE3(Name, A, B, C) ((void)sizeof(A), (void)sizeof(B), (void)sizeof(C))
+#endif
+
+#endif // STANDARDESE_DETAIL_PROBE_HPP_INCLUDED
@@ -224,13 +224,13 @@ public:
     /// \returns An iterator to the first child.
     iterator begin() const noexcept
     {
-        return children_.begin();
+        return children_.data();
     }
 
     /// \returns An iterator one past the last child.
     iterator end() const noexcept
     {
-        return children_.end();
+        return children_.data() + children_.size();
     }
 
     /// \returns The parent of the entity.
@@ -360,6 +360,7 @@ std::unique_ptr<markup::documentation_entity> generate_documentation(
 /// Documentation entity that is being marked as excluded.
 ///
 /// This will be the user data of all excluded [cppast::cpp_entity]().
+/// Children of entities pruned by [standardese::exclude_entities]() don't have any user data.
 class doc_excluded_entity final : public doc_entity
 {
 public:
@@ -720,12 +721,22 @@ public:
     bool is_blacklisted(const cppast::cpp_entity&         entity,
                         cppast::cpp_access_specifier_kind access) const;
 
+    /// \returns Whether or not the given namespace is blacklisted by name,
+    /// i.e. whether it and all of its children are forbidden.
+    bool is_blacklisted(const cppast::cpp_namespace& ns) const;
+
 private:
     std::unordered_set<std::string> ns_blacklist_;
     bool                            extract_private_;
 };
 
 /// Excludes all entities that need excluding.
+/// \effects Excluded entities other than classes or namespaces are pruned,
+/// i.e. only the entity itself is marked and its children aren't visited at all.
+/// The children of excluded classes and namespaces are still marked,
+/// as they might be injected into a derived class.
+/// Inside blacklisted namespaces, only classes and nested namespaces are visited for the same
+/// reason, all other entities are pruned.
 /// \notes This must be called before [standardese::build_doc_entities]() for all files.
 void exclude_entities(const comment_registry& registry, const cppast::cpp_entity_index& index,
                       const entity_blacklist& blacklist, const cppast::cpp_file& file);
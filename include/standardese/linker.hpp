@@ -5,6 +5,7 @@
 #ifndef STANDARDESE_LINKER_HPP_INCLUDED
 #define STANDARDESE_LINKER_HPP_INCLUDED
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <stdexcept>
@@ -33,6 +34,8 @@ namespace markup
 class linker
 {
 public:
+    linker() : frozen_(false) {}
+
     void register_external(std::string namespace_name, std::string url);
 
     /// \effects Registers the given documentation under a certain name.
@@ -43,6 +46,11 @@ public:
     bool register_documentation(std::string link_name, const markup::document_entity& document,
                                 const markup::block_id& documentation, bool force = false) const;
 
+    /// \effects Freezes the linker after all documentations have been registered.
+    /// Afterwards lookups no longer need to synchronize.
+    /// \requires `register_documentation()` must not be called afterwards.
+    void freeze() const;
+
     /// \returns A reference to the documentation for the given linke name, if there is any.
     /// \notes This function is thread safe.
     type_safe::variant<type_safe::nullvar_t, markup::block_reference, markup::url>
@@ -52,6 +60,7 @@ public:
 private:
     mutable std::mutex                                               mutex_;
     mutable std::unordered_map<std::string, markup::block_reference> map_;
+    mutable std::atomic<bool>                                        frozen_;
 
     std::map<std::string, std::string> external_doc_;
 };
@@ -70,6 +79,14 @@ void register_documentations(const cppast::diagnostic_logger& logger, const link
 /// populated.
 void resolve_links(const cppast::diagnostic_logger& logger, const linker& l,
                    const markup::document_entity& document);
+
+/// Resolves links while rendering.
+/// \returns A [standardese::markup::link_resolver]() that resolves links the same way
+/// [standardese::resolve_links]() does, but without modifying the document,
+/// so it can be passed to the generators instead.
+/// \requires The linker must be entirely populated and should be frozen,
+/// the logger and linker must outlive the resolver.
+markup::link_resolver get_link_resolver(const cppast::diagnostic_logger& logger, const linker& l);
 } // namespace standardese
 
 #endif // STANDARDESE_LINKER_HPP_INCLUDED
@@ -89,7 +89,7 @@ namespace markup
         /// details), in the order they were given.
         detail::vector_ptr_range<doc_section> doc_sections() const noexcept
         {
-            return {sections_.begin(), sections_.end()};
+            return {sections_.data(), sections_.data() + sections_.size()};
         }
 
     protected:
@@ -5,6 +5,8 @@
 #ifndef STANDARDESE_MARKUP_ENTITY_HPP_INCLUDED
 #define STANDARDESE_MARKUP_ENTITY_HPP_INCLUDED
 
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -105,8 +107,6 @@ namespace markup
         template <typename T>
         class vector_ptr_iterator
         {
-            using container = std::vector<std::unique_ptr<T>>;
-
         public:
             using value_type        = const T;
             using reference         = const T&;
@@ -116,7 +116,7 @@ namespace markup
 
             vector_ptr_iterator() noexcept : cur_(nullptr) {}
 
-            vector_ptr_iterator(typename container::const_iterator cur) : cur_(cur) {}
+            vector_ptr_iterator(const std::unique_ptr<T>* cur) : cur_(cur) {}
 
             reference operator*() const noexcept
             {
@@ -167,7 +167,7 @@ namespace markup
             }
 
         private:
-            typename container::const_iterator cur_;
+            const std::unique_ptr<T>* cur_;
         };
 
         template <typename T>
@@ -186,6 +186,66 @@ namespace markup
             }
         };
 
+        /// A vector of `std::unique_ptr<T>` that stores the first `N` pointers inline.
+        ///
+        /// Most containers only have a handful of children,
+        /// so this saves the allocation and the additional indirection.
+        template <typename T, std::size_t N>
+        class small_ptr_vector
+        {
+        public:
+            small_ptr_vector() noexcept : size_(0u) {}
+
+            const std::unique_ptr<T>* begin() const noexcept
+            {
+                return on_heap() ? heap_.data() : inline_;
+            }
+
+            const std::unique_ptr<T>* end() const noexcept
+            {
+                return begin() + size_;
+            }
+
+            std::size_t size() const noexcept
+            {
+                return size_;
+            }
+
+            void reserve(std::size_t n)
+            {
+                if (n <= N || n <= heap_.capacity())
+                    return;
+
+                auto was_on_heap = on_heap();
+                heap_.reserve(n);
+                if (!was_on_heap)
+                    for (auto i = 0u; i != size_; ++i)
+                        heap_.push_back(std::move(inline_[i]));
+            }
+
+            void push_back(std::unique_ptr<T> ptr)
+            {
+                if (!on_heap() && size_ < N)
+                    inline_[size_] = std::move(ptr);
+                else
+                {
+                    reserve(2 * size_);
+                    heap_.push_back(std::move(ptr));
+                }
+                ++size_;
+            }
+
+        private:
+            bool on_heap() const noexcept
+            {
+                return heap_.capacity() != 0u;
+            }
+
+            std::unique_ptr<T>              inline_[N];
+            std::vector<std::unique_ptr<T>> heap_;
+            std::size_t                     size_;
+        };
+
         struct parent_updater
         {
             static void set(entity& e, type_safe::object_ref<const entity> parent)
@@ -202,7 +262,8 @@ namespace markup
     template <typename T>
     class container_entity
     {
-        using container = std::vector<std::unique_ptr<T>>;
+        // most containers have between one and three children
+        using container = detail::small_ptr_vector<T, 3>;
 
     public:
         using iterator = detail::vector_ptr_iterator<T>;
@@ -219,6 +280,12 @@ namespace markup
             return children_.end();
         }
 
+        /// \returns The number of child entities.
+        std::size_t size() const noexcept
+        {
+            return children_.size();
+        }
+
     protected:
         ~container_entity() noexcept
         {
@@ -242,6 +309,13 @@ namespace markup
                 return *this;
             }
 
+            /// \effects Reserves storage for `n` children.
+            container_builder& reserve(std::size_t n)
+            {
+                as_container().children_.reserve(n);
+                return *this;
+            }
+
             /// \returns Whether or not the container is empty.
             bool empty() noexcept
             {
@@ -83,6 +83,10 @@ namespace markup
     /// \returns Whether or not the entity is a documentation,
     /// that is, derived from [standardese::markup::documentation_entity]().
     bool is_documentation(entity_kind kind) noexcept;
+
+    /// \returns Whether or not the entity is a document,
+    /// that is, derived from [standardese::markup::document_entity]().
+    bool is_document(entity_kind kind) noexcept;
 } // namespace markup
 } // namespace standardese
 
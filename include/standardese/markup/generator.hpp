@@ -9,6 +9,8 @@
 #include <iosfwd>
 #include <string>
 
+#include <standardese/markup/link.hpp>
+
 namespace standardese
 {
 namespace markup
@@ -28,7 +30,9 @@ namespace markup
     /// An HTML generator.
     ///
     /// \returns A generator that will generate the HTML representation.
-    generator html_generator(const std::string& link_prefix, const std::string& extension) noexcept;
+    /// Unresolved documentation links are resolved using the `resolver`, if there is one.
+    generator html_generator(const std::string& link_prefix, const std::string& extension,
+                             link_resolver resolver = link_resolver()) noexcept;
 
     /// Renders an entity as HTML.
     ///
@@ -43,8 +47,10 @@ namespace markup
     /// \returns A generator that will generate a CommonMark representation.
     /// If `use_html` is `true`, it will use HTML for complex parts that cannot be described using
     /// CommonMark.
+    /// Unresolved documentation links are resolved using the `resolver`, if there is one.
     generator markdown_generator(bool use_html, const std::string& link_prefix,
-                                 const std::string& extension) noexcept;
+                                 const std::string& extension,
+                                 link_resolver resolver = link_resolver()) noexcept;
 
     /// Renders an entity as CommonMark.
     ///
@@ -69,7 +75,9 @@ namespace markup
     /// It will use a simple XML format to describe the markup AST.
     ///
     /// \returns A generator that will generate the XML representation.
-    generator xml_generator(bool include_attributes = true) noexcept;
+    /// Unresolved documentation links are resolved using the `resolver`, if there is one.
+    generator xml_generator(bool          include_attributes = true,
+                            link_resolver resolver           = link_resolver()) noexcept;
 
     /// Renders an entity as XML.
     ///
@@ -5,6 +5,8 @@
 #ifndef STANDARDESE_MARKUP_LINK_HPP_INCLUDED
 #define STANDARDESE_MARKUP_LINK_HPP_INCLUDED
 
+#include <functional>
+
 #include <type_safe/variant.hpp>
 
 #include <standardese/markup/block.hpp>
@@ -87,6 +89,20 @@ namespace markup
         markup::url url_;
     };
 
+    class documentation_link;
+
+    /// The destination of a [standardese::markup::documentation_link]().
+    ///
+    /// `nullvar` means that there is no destination and only the content should be rendered.
+    using link_destination = type_safe::variant<type_safe::nullvar_t, block_reference, markup::url>;
+
+    /// Resolves the destination of an unresolved [standardese::markup::documentation_link]().
+    ///
+    /// It is used by the generators to resolve links while rendering,
+    /// without modifying the link.
+    /// \notes It must be thread safe, as multiple documents might be rendered concurrently.
+    using link_resolver = std::function<link_destination(const documentation_link&)>;
+
     /// A link to another part of the documentation.
     ///
     /// Precisely, a link to another [standardese::markup::block_entity]() or some external URL.
@@ -139,6 +155,11 @@ namespace markup
             return dest_.optional_value(type_safe::variant_type<std::string>{});
         }
 
+        /// \returns The destination of the link.
+        /// If it hasn't been resolved already, it will be resolved using the resolver, if any.
+        /// \notes Unlike `resolve_destination()` this does not modify the link.
+        link_destination destination(const link_resolver& resolver) const;
+
         /// \effects Resolves the destination of the link.
         /// \notes This function is not thread safe.
         /// \group resolve
@@ -0,0 +1,144 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_PROFILER_HPP_INCLUDED
+#define STANDARDESE_PROFILER_HPP_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <type_safe/optional_ref.hpp>
+
+namespace cppast
+{
+class cpp_entity;
+} // namespace cppast
+
+namespace standardese
+{
+/// Attributes the time and allocations spent processing individual entities.
+///
+/// Only the cost of the entity itself is recorded, the cost of nested entities is attributed to
+/// them instead. Profiling is disabled by default, while disabled recording does nothing.
+/// The costs are recorded per thread, and merged once a thread exits or the costs are queried.
+/// Entities are identified by their address, so the costs must be cleared before recorded entities
+/// are destroyed if profiling continues afterwards.
+class entity_profiler
+{
+public:
+    /// The phases the cost is attributed to.
+    enum phase
+    {
+        comment_parse, //< Parsing the comment of an entity.
+        synopsis,      //< [standardese::generate_synopsis]().
+        documentation, //< Generating the documentation of an entity.
+        _phase_count,  //< \exclude
+    };
+
+    /// The cost of processing an entity in a certain phase.
+    struct cost
+    {
+        /// The location of the entity as returned by [*get_location]().
+        /// It is captured when the entity is first recorded, so it can be used after the entity
+        /// has been destroyed.
+        std::string   location;
+        double        seconds;
+        std::uint64_t allocations;
+    };
+
+    /// A function returning the number of allocations done by the calling thread so far.
+    using allocation_counter = std::uint64_t (*)();
+
+    /// \returns The profiler used by the library.
+    static entity_profiler& get() noexcept;
+
+    /// \effects Enables profiling.
+    /// If an allocation counter is given, it is used to attribute allocations as well.
+    /// \requires No entity must be recorded at the moment.
+    void enable(allocation_counter counter = nullptr) noexcept;
+
+    /// \effects Disables profiling and removes all recorded costs.
+    /// \requires No entity must be recorded at the moment.
+    void disable();
+
+    bool enabled() const noexcept
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /// \effects Removes all recorded costs.
+    /// \notes This function is thread safe.
+    void clear();
+
+    /// \returns The `n` most expensive entities of the given phase, most expensive first.
+    /// \notes This function is thread safe.
+    std::vector<cost> most_expensive(phase p, std::size_t n) const;
+
+    /// \returns A description of the location of an entity,
+    /// consisting of the file name and the fully qualified name.
+    static std::string get_location(const cppast::cpp_entity& entity);
+
+    /// Records the cost of an entity while it is alive.
+    ///
+    /// Scopes can be nested on the same thread, the cost of a nested scope is subtracted from the
+    /// outer one.
+    class scope
+    {
+    public:
+        /// \effects Starts recording the cost of the entity, if profiling is enabled.
+        /// If there is no entity, nothing is recorded.
+        scope(phase p, type_safe::optional_ref<const cppast::cpp_entity> entity);
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+        /// \effects Stops recording and adds the cost to the profiler.
+        ~scope();
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        const cppast::cpp_entity* entity_;
+        scope*                    parent_;
+        clock::time_point         start_;
+        clock::duration           nested_time_;
+        std::uint64_t             start_allocations_, nested_allocations_;
+        phase                     phase_;
+    };
+
+private:
+    entity_profiler() noexcept : counter_(nullptr), enabled_(false) {}
+
+    std::uint64_t allocations() const
+    {
+        return counter_ ? counter_() : 0u;
+    }
+
+    using cost_map = std::unordered_map<const cppast::cpp_entity*, cost>;
+
+    // the costs recorded by a single thread
+    struct thread_costs;
+
+    static thread_costs& get_thread_costs();
+
+    void add(phase p, const cppast::cpp_entity& entity, double seconds,
+             std::uint64_t allocations);
+
+    // requires mutex_ to be locked
+    void merge(thread_costs& costs) const;
+
+    mutable std::mutex         mutex_;
+    mutable cost_map           costs_[_phase_count];
+    std::vector<thread_costs*> threads_;
+    allocation_counter         counter_;
+    std::atomic<bool>          enabled_;
+};
+} // namespace standardese
+
+#endif // STANDARDESE_PROFILER_HPP_INCLUDED
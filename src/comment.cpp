@@ -8,6 +8,10 @@
 #include <cppast/cpp_namespace.hpp>
 #include <cppast/visitor.hpp>
 
+#include <standardese/detail/probe.hpp>
+#include <standardese/doc_entity.hpp>
+#include <standardese/profiler.hpp>
+
 #include <algorithm>
 
 #include "get_special_entity.hpp"
@@ -174,17 +178,49 @@ void process_inlines(const cppast::diagnostic_logger&            logger,
 }
 } // namespace
 
-void file_comment_parser::parse(type_safe::object_ref<const cppast::cpp_file> file) const
+void file_comment_parser::parse_impl(
+    type_safe::object_ref<const cppast::cpp_file>   file,
+    type_safe::optional_ref<const entity_blacklist> blacklist) const
 {
+    STANDARDESE_PROBE1(comment__parse__start, file->name().c_str());
+
     comment::parser p(config_);
 
+    // number of entered namespaces that are blacklisted
+    auto blacklisted_depth = 0u;
+
     // add matched comments
-    cppast::visit(*file, [&](const cppast::cpp_entity& entity, const cppast::visitor_info& info) {
+    cppast::visit(*file, [&](const cppast::cpp_entity&   entity,
+                             const cppast::visitor_info& info) -> bool {
+        auto is_namespace = entity.kind() == cppast::cpp_namespace::kind();
         if (info.event == cppast::visitor_info::container_entity_exit)
+        {
             // entity already handled
-            return true;
-        else if (!cppast::is_templated(entity) && !cppast::is_friended(entity))
+            if (is_namespace && blacklisted_depth > 0u)
+                --blacklisted_depth;
+            return cppast::continue_visit;
+        }
+        else if (blacklist && is_namespace
+                 && (blacklisted_depth > 0u
+                     || blacklist.value().is_blacklisted(
+                            static_cast<const cppast::cpp_namespace&>(entity))))
+            ++blacklisted_depth;
+        else if (blacklisted_depth > 0u && entity.parent()
+                 && entity.parent().value().kind() == cppast::cpp_namespace::kind()
+                 && !detail::get_class(entity))
         {
+            // will be excluded and can't be injected anywhere, so don't bother
+            if (info.event == cppast::visitor_info::container_entity_enter)
+                return cppast::continue_visit_no_children;
+            else
+                return cppast::continue_visit;
+        }
+
+        if (!cppast::is_templated(entity) && !cppast::is_friended(entity))
+        {
+            entity_profiler::scope profile(entity_profiler::comment_parse,
+                                           type_safe::opt_ref(&entity));
+
             auto register_commented = [&](type_safe::object_ref<const cppast::cpp_entity> e,
                                           comment::doc_comment                            comment) {
                 this->register_commented(e, std::move(comment));
@@ -228,7 +264,7 @@ void file_comment_parser::parse(type_safe::object_ref<const cppast::cpp_file> fi
             process_inlines(*logger_, comment, entity, register_commented, register_uncommented);
         }
 
-        return true;
+        return cppast::continue_visit;
     });
 
     // add free comments
@@ -267,6 +303,8 @@ void file_comment_parser::parse(type_safe::object_ref<const cppast::cpp_file> fi
                       make_diagnostic(cppast::source_location::make_file(file->name(), free.line),
                                       "unmatched comment doesn't have a remote entity specified"));
     }
+
+    STANDARDESE_PROBE1(comment__parse__end, file->name().c_str());
 }
 
 comment_registry file_comment_parser::finish()
@@ -24,6 +24,7 @@
 #include <standardese/markup/entity_kind.hpp>
 #include <standardese/markup/heading.hpp>
 #include <standardese/markup/link.hpp>
+#include <standardese/profiler.hpp>
 
 #include "entity_visitor.hpp"
 #include "get_special_entity.hpp"
@@ -60,11 +61,13 @@ namespace
 // tag object to mark an excluded entity
 doc_excluded_entity excluded_entity;
 doc_excluded_entity parent_excluded_entity;
+doc_excluded_entity blacklisted_entity;
 } // namespace
 
 bool doc_entity::is_excluded() const noexcept
 {
-    auto result = this == &excluded_entity || this == &parent_excluded_entity;
+    auto result
+        = this == &excluded_entity || this == &parent_excluded_entity || this == &blacklisted_entity;
     assert(!result || kind() == excluded);
     return result;
 }
@@ -492,6 +495,33 @@ private:
     type_safe::flag render_injected_;
 };
 
+namespace
+{
+// the entity the cost of a doc entity is attributed to
+type_safe::optional_ref<const cppast::cpp_entity> get_profiled_entity(const doc_entity& entity)
+{
+    switch (entity.kind())
+    {
+    case doc_entity::cpp_entity:
+        return type_safe::opt_ref(&static_cast<const doc_cpp_entity&>(entity).entity());
+    case doc_entity::metadata:
+        return type_safe::opt_ref(&static_cast<const doc_metadata_entity&>(entity).entity());
+    case doc_entity::cpp_namespace:
+        return type_safe::opt_ref(&static_cast<const doc_cpp_namespace&>(entity).namespace_());
+    case doc_entity::cpp_file:
+        return type_safe::opt_ref(&static_cast<const doc_cpp_file&>(entity).file());
+    case doc_entity::member_group:
+        // attribute it to the main entity of the group
+        return get_profiled_entity(*entity.begin());
+
+    case doc_entity::excluded:
+        break;
+    }
+
+    return nullptr;
+}
+} // namespace
+
 std::unique_ptr<markup::code_block> standardese::generate_synopsis(
     const synopsis_config& config, const cppast::cpp_entity_index& index, const doc_entity& entity)
 {
@@ -500,6 +530,8 @@ std::unique_ptr<markup::code_block> standardese::generate_synopsis(
         return generate_synopsis(config, index, entity.parent().value());
     else
     {
+        entity_profiler::scope profile(entity_profiler::synopsis, get_profiled_entity(entity));
+
         detail::markdown_code_generator generator(type_safe::ref(config), type_safe::ref(index));
         entity.do_generate_code(generator);
         return generator.finish();
@@ -798,6 +830,8 @@ std::unique_ptr<markup::documentation_entity> doc_cpp_entity::do_generate_docume
     type_safe::optional_ref<detail::inline_entity_list> inlines,
     std::unique_ptr<markup::code_block>                 synopsis) const
 {
+    entity_profiler::scope profile(entity_profiler::documentation, type_safe::opt_ref(&entity()));
+
     auto inline_doc
         = gen_config.is_flag_set(generation_config::inline_doc) && empty_sections(comment());
 
@@ -901,6 +935,9 @@ std::unique_ptr<markup::documentation_entity> doc_cpp_namespace::do_generate_doc
     const cppast::cpp_entity_index&     index, type_safe::optional_ref<detail::inline_entity_list>,
     std::unique_ptr<markup::code_block> synopsis) const
 {
+    entity_profiler::scope profile(entity_profiler::documentation,
+                                   type_safe::opt_ref(&namespace_()));
+
     // generate child documentation
     std::vector<std::unique_ptr<markup::entity_documentation>> child_docs;
     for (auto& child : *this)
@@ -932,6 +969,7 @@ std::unique_ptr<markup::documentation_entity> doc_cpp_namespace::do_generate_doc
         // generate empty namespace documentation
         markup::entity_documentation::builder builder(entity_, get_documentation_id(),
                                                       type_safe::nullopt, nullptr);
+        builder.reserve(child_docs.size());
         for (auto& doc : child_docs)
             builder.add_child(std::move(doc));
 
@@ -955,6 +993,8 @@ std::unique_ptr<markup::documentation_entity> doc_cpp_file::do_generate_document
     const cppast::cpp_entity_index&     index, type_safe::optional_ref<detail::inline_entity_list>,
     std::unique_ptr<markup::code_block> synopsis) const
 {
+    entity_profiler::scope profile(entity_profiler::documentation, type_safe::opt_ref(&file()));
+
     markup::file_documentation::builder builder(type_safe::ref(*file_), get_documentation_id(),
                                                 get_header(*file_, comment(), output_name()),
                                                 std::move(synopsis));
@@ -1050,28 +1090,31 @@ bool entity_blacklist::is_blacklisted(const cppast::cpp_entity&         entity,
         && !is_friend_func_def(entity))
         return true;
     else if (entity.kind() == cppast::cpp_namespace::kind())
-    {
-        auto name = entity.name();
-        if (ns_blacklist_.count(name))
-            return true;
+        return is_blacklisted(static_cast<const cppast::cpp_namespace&>(entity));
+    else
+        return false;
+}
+
+bool entity_blacklist::is_blacklisted(const cppast::cpp_namespace& ns) const
+{
+    auto name = ns.name();
+    if (ns_blacklist_.count(name))
+        return true;
 
-        for (auto cur = entity.parent(); cur; cur = cur.value().parent())
+    for (auto cur = ns.parent(); cur; cur = cur.value().parent())
+    {
+        auto scope = cur.value().scope_name();
+        if (scope
+            // Do not prepend a "::" for unnamed namespaces
+            && scope.value().name() != "")
         {
-            auto scope = cur.value().scope_name();
-            if (scope
-                // Do not prepend a "::" for unnamed namespaces
-                && scope.value().name() != "")
-            {
-                name = scope.value().name() + "::" + name;
-                if (ns_blacklist_.count(name))
-                    return true;
-            }
+            name = scope.value().name() + "::" + name;
+            if (ns_blacklist_.count(name))
+                return true;
         }
-
-        return false;
     }
-    else
-        return false;
+
+    return false;
 }
 
 namespace
@@ -1329,7 +1372,7 @@ std::unique_ptr<doc_cpp_namespace> build_namespace(const comment_registry&
 
 bool build_is_excluded(const cppast::cpp_entity_index& index, const cppast::cpp_entity& e)
 {
-    if (e.user_data() == &excluded_entity)
+    if (e.user_data() == &excluded_entity || e.user_data() == &blacklisted_entity)
         // allow parent_excluded_entity here, will not be visited unless injected
         return true;
     else if (cppast::is_templated(e) || cppast::is_friended(e))
@@ -1387,11 +1430,41 @@ void standardese::exclude_entities(const comment_registry&         registry,
                   entity.set_user_data(&parent_excluded_entity);
           };
 
-    cppast::visit(file, [&](const cppast::cpp_entity& entity, const cppast::visitor_info& info) {
+    cppast::visit(file, [&](const cppast::cpp_entity&   entity,
+                            const cppast::visitor_info& info) -> bool {
         if (info.is_old_entity())
-            return;
+            return cppast::continue_visit;
+
+        auto in_blacklisted = entity.parent()
+                              && entity.parent().value().user_data() == &blacklisted_entity;
+        if (entity.kind() == cppast::cpp_namespace::kind()
+            && (in_blacklisted
+                || blacklist.is_blacklisted(static_cast<const cppast::cpp_namespace&>(entity))))
+        {
+            // exclude the namespace, but classes inside can still be injected
+            entity.set_user_data(&blacklisted_entity);
+            return cppast::continue_visit;
+        }
+        else if (in_blacklisted && !detail::get_class(entity))
+        {
+            // can't be injected anywhere, so no need to visit the children
+            entity.set_user_data(&parent_excluded_entity);
+            if (info.event == cppast::visitor_info::container_entity_enter)
+                return cppast::continue_visit_no_children;
+            else
+                return cppast::continue_visit;
+        }
 
         exclude_if_necessary(entity, info.access);
+        if (entity.user_data() == &excluded_entity && !is_class(entity)
+            && entity.kind() != cppast::cpp_namespace::kind())
+        {
+            // children can't be injected anywhere, so no need to visit them
+            if (info.event == cppast::visitor_info::container_entity_enter)
+                return cppast::continue_visit_no_children;
+            else
+                return cppast::continue_visit;
+        }
 
         // handle inline entities
         if (auto templ = detail::get_template(entity))
@@ -1406,6 +1479,8 @@ void standardese::exclude_entities(const comment_registry&         registry,
         if (auto c = detail::get_class(entity))
             for (auto& base : c.value().bases())
                 exclude_if_necessary(base, base.access_specifier());
+
+        return cppast::continue_visit;
     });
 }
 
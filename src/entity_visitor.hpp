@@ -13,6 +13,7 @@ namespace standardese
 {
 namespace detail
 {
+    // NamespaceFunc returns whether or not the children of the namespace are visited
     template <typename EntityFunc, typename NamespaceFunc>
     void visit_namespace_level(const cppast::cpp_file& file, EntityFunc ef, NamespaceFunc nf)
     {
@@ -28,10 +29,8 @@ namespace detail
 
                               case cppast::visitor_info::container_entity_enter:
                                   if (e.kind() == cppast::cpp_entity_kind::namespace_t)
-                                  {
-                                      nf(static_cast<const cppast::cpp_namespace&>(e));
-                                      return true; // continue with children
-                                  }
+                                      // continue with children, unless requested otherwise
+                                      return nf(static_cast<const cppast::cpp_namespace&>(e));
                                   else if (e.kind() == cppast::cpp_entity_kind::language_linkage_t)
                                       return true; // continue with children
                                   else
@@ -52,7 +51,7 @@ namespace detail
     template <typename EntityFunc>
     void visit_namespace_level(const cppast::cpp_file& file, EntityFunc ef)
     {
-        visit_namespace_level(file, ef, [](const cppast::cpp_namespace&) {});
+        visit_namespace_level(file, ef, [](const cppast::cpp_namespace&) { return true; });
     }
 
     template <typename Func>
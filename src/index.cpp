@@ -19,6 +19,7 @@
 #include <standardese/markup/link.hpp>
 
 #include "entity_visitor.hpp"
+#include "get_special_entity.hpp"
 
 using namespace standardese;
 
@@ -213,13 +214,17 @@ void standardese::register_index_entities(const entity_index& index, const cppas
                                   },
                                   [&](const cppast::cpp_namespace& ns) {
                                       auto doc_e = static_cast<const doc_entity*>(ns.user_data());
-                                      if (doc_e && !doc_e->is_excluded())
+                                      if (doc_e && doc_e->is_excluded())
+                                          // skip the entire namespace
+                                          return false;
+                                      else if (doc_e)
                                           // it's not an excluded entity, so register it
                                           index.register_namespace(ns,
                                                                    static_cast<
                                                                        const doc_cpp_namespace*>(
                                                                        doc_e)
                                                                        ->get_builder());
+                                      return true;
                                   });
 }
 
@@ -323,8 +328,14 @@ void standardese::register_module_entities(const module_index&     index,
         return builder;
     };
 
-    cppast::visit(file, [&](const cppast::cpp_entity& e, const cppast::visitor_info& info) {
-        if (info.event != cppast::visitor_info::container_entity_exit)
+    cppast::visit(file, [&](const cppast::cpp_entity& e, const cppast::visitor_info& info) -> bool {
+        auto doc_e = static_cast<const doc_entity*>(e.user_data());
+        if (info.event == cppast::visitor_info::container_entity_enter && doc_e
+            && doc_e->is_excluded() && e.kind() != cppast::cpp_namespace::kind()
+            && !detail::get_class(e))
+            // the children can't be injected anywhere, so they can't be part of a module
+            return cppast::continue_visit_no_children;
+        else if (info.event != cppast::visitor_info::container_entity_exit)
         {
             auto module = get_module(e);
             if (module && !register_entity(module.value(), e))
@@ -12,6 +12,7 @@
 #include <cppast/cpp_namespace.hpp>
 #include <cppast/visitor.hpp>
 
+#include <standardese/detail/probe.hpp>
 #include <standardese/doc_entity.hpp>
 #include <standardese/logger.hpp>
 #include <standardese/markup/document.hpp>
@@ -100,6 +101,7 @@ std::string short_link_name(const std::string& name)
 bool linker::register_documentation(std::string link_name, const markup::document_entity& document,
                                     const markup::block_id& documentation, bool force) const
 {
+    assert(!frozen_.load(std::memory_order_relaxed));
     auto ref = markup::block_reference(document.output_name(), documentation);
 
     link_name       = process_link_name(std::move(link_name));
@@ -134,6 +136,12 @@ bool linker::register_documentation(std::string link_name, const markup::documen
     return true;
 }
 
+void linker::freeze() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    frozen_.store(true, std::memory_order_release);
+}
+
 namespace
 {
 bool has_scope(const std::string& str, const std::string& scope)
@@ -187,8 +195,11 @@ type_safe::variant<type_safe::nullvar_t, markup::block_reference, markup::url> l
     // performs local lookup
     auto do_lookup = [&](const std::string& link_name)
         -> type_safe::variant<type_safe::nullvar_t, markup::block_reference, markup::url> {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto                        iter = map_.find(process_link_name(link_name));
+        std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+        if (!frozen_.load(std::memory_order_acquire))
+            lock.lock();
+
+        auto iter = map_.find(process_link_name(link_name));
         if (iter == map_.end())
             return type_safe::nullvar;
         return iter->second;
@@ -263,6 +274,12 @@ type_safe::optional_ref<const doc_entity> get_doc_entity(const cppast::cpp_entit
         return type_safe::ref(doc_e);
 }
 
+bool is_excluded(const cppast::cpp_entity& e)
+{
+    auto user_data = e.user_data();
+    return user_data && static_cast<const doc_entity*>(user_data)->is_excluded();
+}
+
 bool force_linking(const doc_entity& doc_e)
 {
     if (doc_e.kind() == doc_entity::cpp_entity)
@@ -302,11 +319,16 @@ void standardese::register_documentations(const cppast::diagnostic_logger& logge
     visit_documentations(document,
                          [&](const markup::file_documentation& file) {
                              cppast::visit(file.file(), [&](const cppast::cpp_entity&   e,
-                                                            const cppast::visitor_info& info) {
-                                 if (info.event != cppast::visitor_info::container_entity_exit
-                                     && !cppast::is_templated(e) && !cppast::is_friended(e)
-                                     && e.kind()
-                                            != cppast::cpp_namespace::kind()) // if not already done
+                                                            const cppast::visitor_info& info)
+                                                                -> bool {
+                                 if (info.event == cppast::visitor_info::container_entity_enter
+                                     && is_excluded(e))
+                                     // injected children are registered by the derived class
+                                     return cppast::continue_visit_no_children;
+                                 else if (info.event != cppast::visitor_info::container_entity_exit
+                                          && !cppast::is_templated(e) && !cppast::is_friended(e)
+                                          && e.kind() != cppast::cpp_namespace::kind())
+                                     // if not already done
                                  {
                                      register_doc(e);
 
@@ -359,62 +381,104 @@ cppast::source_location get_location(const markup::document_entity&    document,
 }
 } // namespace
 
-void standardese::resolve_links(const cppast::diagnostic_logger& logger, const linker& l,
-                                const markup::document_entity& document)
+namespace
 {
-    auto get_context
-        = [](const markup::entity& entity) -> type_safe::optional_ref<const cppast::cpp_entity> {
-        if (entity.kind() == markup::entity_kind::file_documentation)
-            return type_safe::opt_ref(
-                &static_cast<const markup::file_documentation&>(entity).file());
-        else if (entity.kind() == markup::entity_kind::entity_documentation)
-            return type_safe::opt_ref(
-                &static_cast<const markup::entity_documentation&>(entity).entity());
-        else if (entity.kind() == markup::entity_kind::namespace_documentation)
-            return type_safe::opt_ref(
-                &static_cast<const markup::namespace_documentation&>(entity).namespace_());
-        else
-            return nullptr;
-    };
+type_safe::optional_ref<const cppast::cpp_entity> get_context(const markup::entity& entity)
+{
+    if (entity.kind() == markup::entity_kind::file_documentation)
+        return type_safe::opt_ref(&static_cast<const markup::file_documentation&>(entity).file());
+    else if (entity.kind() == markup::entity_kind::entity_documentation)
+        return type_safe::opt_ref(
+            &static_cast<const markup::entity_documentation&>(entity).entity());
+    else if (entity.kind() == markup::entity_kind::namespace_documentation)
+        return type_safe::opt_ref(
+            &static_cast<const markup::namespace_documentation&>(entity).namespace_());
+    else
+        return nullptr;
+}
 
-    auto get_documentation_block = [](const markup::entity& entity) {
-        for (auto cur = entity.parent(); cur; cur = cur.value().parent())
-            if (markup::is_documentation(cur.value().kind()))
-                return static_cast<const markup::documentation_entity&>(cur.value()).id();
+markup::block_id get_documentation_block(const markup::entity& entity)
+{
+    for (auto cur = entity.parent(); cur; cur = cur.value().parent())
+        if (markup::is_documentation(cur.value().kind()))
+            return static_cast<const markup::documentation_entity&>(cur.value()).id();
 
-        assert(false);
-        return markup::block_id();
-    };
+    assert(false);
+    return markup::block_id();
+}
+
+markup::link_destination resolve_link(const cppast::diagnostic_logger& logger, const linker& l,
+                                      const markup::document_entity&                    document,
+                                      type_safe::optional_ref<const cppast::cpp_entity> context,
+                                      const markup::documentation_link&                 link)
+{
+    auto& unresolved = link.unresolved_destination().value();
+
+    STANDARDESE_PROBE1(link__lookup__start, unresolved.c_str());
+    auto destination = l.lookup_documentation(context, unresolved);
+    STANDARDESE_PROBE2(link__lookup__end, unresolved.c_str(), destination.has_value() ? 1 : 0);
+    if (auto block
+        = destination.optional_value(type_safe::variant_type<markup::block_reference>{}))
+    {
+        auto same_document = !block.value().document()
+                             || block.value().document().value().name()
+                                    == document.output_name().name();
+        if (same_document
+            && block.value().id().as_str() == get_documentation_block(link).as_str())
+            // only resolve if points to something different
+            return type_safe::nullvar;
+    }
+    else if (!destination.has_value(type_safe::variant_type<markup::url>{}))
+        logger.log("standardese linker", make_diagnostic(get_location(document, link),
+                                                         "unresolved link name '", unresolved,
+                                                         '\''));
 
+    return destination;
+}
+} // namespace
+
+void standardese::resolve_links(const cppast::diagnostic_logger& logger, const linker& l,
+                                const markup::document_entity& document)
+{
     type_safe::optional_ref<const cppast::cpp_entity> context;
     markup::visit(document, [&](const markup::entity& entity) {
         if (entity.kind() == markup::entity_kind::documentation_link)
         {
             auto& link = static_cast<const markup::documentation_link&>(entity);
-            if (auto unresolved = link.unresolved_destination())
-            {
-                auto destination = l.lookup_documentation(context, unresolved.value());
-                if (auto block = destination.optional_value(
-                        type_safe::variant_type<markup::block_reference>{}))
-                {
-                    auto same_document = !block.value().document()
-                                         || block.value().document().value().name()
-                                                == document.output_name().name();
-                    if (!same_document
-                        || block.value().id().as_str() != get_documentation_block(entity).as_str())
-                        // only resolve if points to something different
-                        link.resolve_destination(block.value());
-                }
-                else if (auto url
-                         = destination.optional_value(type_safe::variant_type<markup::url>{}))
-                    link.resolve_destination(url.value());
-                else
-                    logger.log("standardese linker",
-                               make_diagnostic(get_location(document, link),
-                                               "unresolved link name '", unresolved.value(), '\''));
-            }
+            if (!link.unresolved_destination())
+                return;
+
+            auto destination = resolve_link(logger, l, document, context, link);
+            if (auto block = destination.optional_value(
+                    type_safe::variant_type<markup::block_reference>{}))
+                link.resolve_destination(block.value());
+            else if (auto url = destination.optional_value(type_safe::variant_type<markup::url>{}))
+                link.resolve_destination(url.value());
         }
         else if (auto new_context = get_context(entity))
             context = new_context;
     });
 }
+
+markup::link_resolver standardese::get_link_resolver(const cppast::diagnostic_logger& logger,
+                                                     const linker&                    l)
+{
+    return [&logger, &l](const markup::documentation_link& link) -> markup::link_destination {
+        // the context is given by the innermost documentation,
+        // the document is the root of the tree
+        type_safe::optional_ref<const cppast::cpp_entity> context;
+        const markup::entity*                             root = &link;
+        for (auto cur = link.parent(); cur; cur = cur.value().parent())
+        {
+            if (!context)
+                context = get_context(cur.value());
+            root = &cur.value();
+        }
+
+        if (!markup::is_document(root->kind()))
+            // not part of a document, can't resolve it
+            return type_safe::nullvar;
+        return resolve_link(logger, l, static_cast<const markup::document_entity&>(*root), context,
+                            link);
+    };
+}
@@ -57,6 +57,7 @@ void code_block::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> code_block::do_clone() const
 {
     builder b(id(), language());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
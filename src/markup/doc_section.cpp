@@ -86,6 +86,7 @@ void brief_section::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> brief_section::do_clone() const
 {
     builder b;
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
@@ -105,6 +106,7 @@ void details_section::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> details_section::do_clone() const
 {
     builder b;
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<block_entity>(child.clone()));
     return b.finish();
@@ -24,6 +24,7 @@ entity_kind main_document::do_get_kind() const noexcept
 std::unique_ptr<entity> main_document::do_clone() const
 {
     builder b(title(), output_name().name());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<block_entity>(child.clone()));
     return b.finish();
@@ -37,6 +38,7 @@ entity_kind subdocument::do_get_kind() const noexcept
 std::unique_ptr<entity> subdocument::do_clone() const
 {
     builder b(title(), output_name().name());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<block_entity>(child.clone()));
     return b.finish();
@@ -65,6 +67,7 @@ entity_kind template_document::do_get_kind() const noexcept
 std::unique_ptr<entity> template_document::do_clone() const
 {
     builder b(title(), output_name().name());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<block_entity>(child.clone()));
     return b.finish();
@@ -59,6 +59,7 @@ std::unique_ptr<entity> entity_documentation::do_clone() const
               synopsis() ? markup::clone(synopsis().value()) : nullptr);
     for (auto& sec : doc_sections())
         b.add_section_impl(detail::unchecked_downcast<doc_section>(sec.clone()));
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<entity_documentation>(child.clone()));
     return b.finish();
@@ -90,6 +91,7 @@ std::unique_ptr<entity> file_documentation::do_clone() const
               synopsis() ? markup::clone(synopsis().value()) : nullptr);
     for (auto& sec : doc_sections())
         b.add_section_impl(detail::unchecked_downcast<doc_section>(sec.clone()));
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<entity_documentation>(child.clone()));
     return b.finish();
@@ -22,6 +22,7 @@ void heading::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> heading::do_clone() const
 {
     builder b(id());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
@@ -41,6 +42,7 @@ void subheading::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> subheading::do_clone() const
 {
     builder b(id());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
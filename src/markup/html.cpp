@@ -37,14 +37,15 @@ class html_stream
 {
 public:
     explicit html_stream(type_safe::object_ref<std::ostream> out, std::string prefix,
-                         std::string extension)
-    : out_(out), prefix_(std::move(prefix)), ext_(std::move(extension)), top_level_(true),
-      closing_newl_(false)
+                         std::string extension, const link_resolver& resolver)
+    : out_(out), resolver_(type_safe::ref(resolver)), prefix_(std::move(prefix)),
+      ext_(std::move(extension)), top_level_(true), closing_newl_(false)
     {}
 
     html_stream(html_stream&& other)
-    : closing_(std::move(other.closing_)), out_(other.out_), prefix_(std::move(other.prefix_)),
-      ext_(other.extension()), top_level_(other.top_level_), closing_newl_(other.closing_newl_)
+    : closing_(std::move(other.closing_)), out_(other.out_), resolver_(other.resolver_),
+      prefix_(std::move(other.prefix_)), ext_(other.extension()), top_level_(other.top_level_),
+      closing_newl_(other.closing_newl_)
     {
         other.closing_.clear();
         other.top_level_.reset();
@@ -63,6 +64,11 @@ public:
         return ext_;
     }
 
+    const link_resolver& resolver() const noexcept
+    {
+        return *resolver_;
+    }
+
     // opens a new tag
     // destructor stream object will write closing one
     html_stream open_tag(bool open_newl, bool closing_newl, const char* tag)
@@ -92,7 +98,7 @@ public:
         if (open_newl)
             *out_ << "\n";
 
-        return html_stream(out_, prefix_, extension(), tag, closing_newl);
+        return html_stream(out_, resolver_, prefix_, extension(), tag, closing_newl);
     }
 
     html_stream open_link(const char* title, const char* url, bool prefix)
@@ -109,7 +115,7 @@ public:
             *out_ << '"';
         }
         *out_ << ">";
-        return html_stream(out_, prefix_, extension(), "a", false);
+        return html_stream(out_, resolver_, prefix_, extension(), "a", false);
     }
 
     // closes the current tag
@@ -146,16 +152,18 @@ public:
     }
 
 private:
-    explicit html_stream(type_safe::object_ref<std::ostream> out, std::string prefix,
+    explicit html_stream(type_safe::object_ref<std::ostream>        out,
+                         type_safe::object_ref<const link_resolver> resolver, std::string prefix,
                          std::string extension, std::string closing, bool closing_newl)
-    : closing_(std::move(closing)), out_(out), prefix_(std::move(prefix)),
+    : closing_(std::move(closing)), out_(out), resolver_(resolver), prefix_(std::move(prefix)),
       ext_(std::move(extension)), top_level_(false), closing_newl_(closing_newl)
     {}
 
-    std::string                         closing_;
-    type_safe::object_ref<std::ostream> out_;
-    std::string                         prefix_, ext_;
-    type_safe::flag                     top_level_, closing_newl_;
+    std::string                                closing_;
+    type_safe::object_ref<std::ostream>        out_;
+    type_safe::object_ref<const link_resolver> resolver_;
+    std::string                                prefix_, ext_;
+    type_safe::flag                            top_level_, closing_newl_;
 };
 
 void write_entity(html_stream& s, const entity& e);
@@ -613,21 +621,21 @@ void write(html_stream& s, const external_link& link)
 
 void write(html_stream& s, const documentation_link& link)
 {
-    if (link.internal_destination())
+    auto destination = link.destination(s.resolver());
+    if (auto internal = destination.optional_value(type_safe::variant_type<block_reference>{}))
     {
-        auto url = link.internal_destination()
-                       .value()
+        auto url = internal.value()
                        .document()
                        .map(&output_name::file_name, s.extension().c_str())
                        .value_or("");
-        url += "#standardese-" + link.internal_destination().value().id().as_output_str();
+        url += "#standardese-" + internal.value().id().as_output_str();
 
         auto a = s.open_link(link.title().c_str(), url.c_str(), true);
         write_children(a, link);
     }
-    else if (link.external_destination())
+    else if (auto external = destination.optional_value(type_safe::variant_type<markup::url>{}))
     {
-        auto url = link.external_destination().value().as_str();
+        auto url = external.value().as_str();
 
         auto a = s.open_link(link.title().c_str(), url.c_str(), false);
         write_children(a, link);
@@ -713,10 +721,11 @@ void write_entity(html_stream& s, const entity& e)
 } // namespace
 
 generator standardese::markup::html_generator(const std::string& prefix,
-                                              const std::string& extension) noexcept
+                                              const std::string& extension,
+                                              link_resolver      resolver) noexcept
 {
-    return [prefix, extension](std::ostream& out, const entity& e) {
-        html_stream s(type_safe::ref(out), prefix, extension);
+    return [prefix, extension, resolver](std::ostream& out, const entity& e) {
+        html_stream s(type_safe::ref(out), prefix, extension, resolver);
         write_entity(s, e);
     };
 }
@@ -44,6 +44,7 @@ void file_index::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> file_index::do_clone() const
 {
     builder b(detail::unchecked_downcast<markup::heading>(heading().clone()));
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<entity_index_item>(child.clone()));
     return b.finish();
@@ -71,6 +72,7 @@ std::unique_ptr<entity> namespace_documentation::do_clone() const
               header() ? type_safe::make_optional(header().value().clone()) : type_safe::nullopt);
     for (auto& sec : doc_sections())
         b.add_section_impl(detail::unchecked_downcast<doc_section>(sec.clone()));
+    b.reserve(size());
     for (auto& child : *this)
         b.container_builder::add_child(detail::unchecked_downcast<block_entity>(child.clone()));
     return b.finish();
@@ -91,6 +93,7 @@ void entity_index::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> entity_index::do_clone() const
 {
     builder b(detail::unchecked_downcast<markup::heading>(heading().clone()));
+    b.reserve(size());
     for (auto& child : *this)
         b.container_builder::add_child(
             detail::unchecked_downcast<markup::block_entity>(child.clone()));
@@ -119,6 +122,7 @@ std::unique_ptr<entity> module_documentation::do_clone() const
               header() ? type_safe::make_optional(header().value().clone()) : type_safe::nullopt);
     for (auto& sec : doc_sections())
         b.add_section_impl(detail::unchecked_downcast<doc_section>(sec.clone()));
+    b.reserve(size());
     for (auto& child : *this)
         b.container_builder::add_child(
             detail::unchecked_downcast<entity_index_item>(child.clone()));
@@ -140,6 +144,7 @@ void module_index::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> module_index::do_clone() const
 {
     builder b(detail::unchecked_downcast<markup::heading>(heading().clone()));
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<module_documentation>(child.clone()));
     return b.finish();
@@ -22,6 +22,7 @@ entity_kind external_link::do_get_kind() const noexcept
 std::unique_ptr<entity> external_link::do_clone() const
 {
     builder b(title(), url());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
@@ -32,6 +33,18 @@ entity_kind documentation_link::do_get_kind() const noexcept
     return entity_kind::documentation_link;
 }
 
+link_destination documentation_link::destination(const link_resolver& resolver) const
+{
+    if (auto internal = internal_destination())
+        return internal.value();
+    else if (auto external = external_destination())
+        return external.value();
+    else if (resolver)
+        return resolver(*this);
+    else
+        return type_safe::nullvar;
+}
+
 std::unique_ptr<entity> documentation_link::do_clone() const
 {
     builder b(title(), type_safe::copy(unresolved_destination()).value_or(""));
@@ -41,6 +54,7 @@ std::unique_ptr<entity> documentation_link::do_clone() const
     else if (external_destination())
         b.peek().resolve_destination(external_destination().value());
 
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
 
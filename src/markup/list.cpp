@@ -22,6 +22,7 @@ void list_item::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> list_item::do_clone() const
 {
     builder b(id());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<block_entity>(child.clone()));
     return b.finish();
@@ -41,6 +42,7 @@ void term::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> term::do_clone() const
 {
     builder b;
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
@@ -60,6 +62,7 @@ void description::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> description::do_clone() const
 {
     builder b;
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
@@ -96,6 +99,7 @@ void unordered_list::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> unordered_list::do_clone() const
 {
     builder b(id());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_item(detail::unchecked_downcast<list_item_base>(child.clone()));
     return b.finish();
@@ -115,6 +119,7 @@ void ordered_list::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> ordered_list::do_clone() const
 {
     builder b(id());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_item(detail::unchecked_downcast<list_item_base>(child.clone()));
     return b.finish();
@@ -33,8 +33,9 @@ namespace
 {
 struct options
 {
-    std::string prefix, extension;
-    bool        use_html;
+    std::string   prefix, extension;
+    bool          use_html;
+    link_resolver resolver;
 };
 
 void build_entity(cmark_node* parent, const options& opt, const entity& e);
@@ -546,25 +547,29 @@ void build(cmark_node* parent, const options& opt, const external_link& link)
 void build(cmark_node* parent, const options& opt, const documentation_link& link)
 {
     if (cmark_node_get_type(parent) == CMARK_NODE_CODE_BLOCK)
+    {
         handle_children(parent, opt, link);
-    else if (link.internal_destination())
+        return;
+    }
+
+    auto destination = link.destination(opt.resolver);
+    if (auto internal = destination.optional_value(type_safe::variant_type<block_reference>{}))
     {
         auto url = opt.prefix
-                   + link.internal_destination()
-                         .value()
+                   + internal.value()
                          .document()
                          .map(&output_name::file_name, opt.extension.c_str())
                          .value_or("");
-        url += "#standardese-" + link.internal_destination().value().id().as_output_str();
+        url += "#standardese-" + internal.value().id().as_output_str();
 
         auto node = build_link(link.title().c_str(), url.c_str());
         cmark_node_append_child(parent, node);
 
         handle_children(node, opt, link);
     }
-    else if (link.external_destination())
+    else if (auto external = destination.optional_value(type_safe::variant_type<markup::url>{}))
     {
-        auto url = link.external_destination().value().as_str();
+        auto url = external.value().as_str();
 
         auto node = build_link(link.title().c_str(), url.c_str());
         cmark_node_append_child(parent, node);
@@ -666,9 +671,10 @@ cmark_node* build_entity(const options& opt, const entity& e)
 } // namespace
 
 generator standardese::markup::markdown_generator(bool use_html, const std::string& prefix,
-                                                  const std::string& extension) noexcept
+                                                  const std::string& extension,
+                                                  link_resolver      resolver) noexcept
 {
-    options opt{prefix, extension, use_html};
+    options opt{prefix, extension, use_html, std::move(resolver)};
     return [opt](std::ostream& out, const entity& e) {
         auto doc = build_entity(opt, e);
 
@@ -682,7 +688,7 @@ generator standardese::markup::markdown_generator(bool use_html, const std::stri
 
 generator standardese::markup::text_generator() noexcept
 {
-    options opt{"", "txt", false};
+    options opt{"", "txt", false, link_resolver()};
     return [opt](std::ostream& out, const entity& e) {
         auto doc = build_entity(opt, e);
 
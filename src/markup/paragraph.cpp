@@ -22,6 +22,7 @@ void paragraph::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> paragraph::do_clone() const
 {
     builder b(id());
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
@@ -34,6 +34,7 @@ void emphasis::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> emphasis::do_clone() const
 {
     builder b;
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
@@ -53,6 +54,7 @@ void strong_emphasis::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> strong_emphasis::do_clone() const
 {
     builder b;
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
@@ -72,6 +74,7 @@ void code::do_visit(detail::visitor_callback_t cb, void* mem) const
 std::unique_ptr<entity> code::do_clone() const
 {
     builder b;
+    b.reserve(size());
     for (auto& child : *this)
         b.add_child(detail::unchecked_downcast<phrasing_entity>(child.clone()));
     return b.finish();
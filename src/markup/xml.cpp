@@ -32,13 +32,14 @@ namespace
 class xml_stream
 {
 public:
-    xml_stream(type_safe::object_ref<std::ostream> out, bool include_attributes = true)
-    : out_(out), newl_(false), attributes_(include_attributes)
+    xml_stream(type_safe::object_ref<std::ostream> out, bool include_attributes,
+               const link_resolver& resolver)
+    : out_(out), resolver_(type_safe::ref(resolver)), newl_(false), attributes_(include_attributes)
     {}
 
     xml_stream(xml_stream&& other)
-    : closing_(std::move(other.closing_)), out_(other.out_), newl_(other.newl_),
-      attributes_(other.attributes_)
+    : closing_(std::move(other.closing_)), out_(other.out_), resolver_(other.resolver_),
+      newl_(other.newl_), attributes_(other.attributes_)
     {
         other.closing_.clear();
         other.newl_.reset();
@@ -51,6 +52,11 @@ public:
 
     xml_stream& operator=(const xml_stream&) = delete;
 
+    const link_resolver& resolver() const noexcept
+    {
+        return *resolver_;
+    }
+
     enum tag_kind
     {
         block_tag,
@@ -113,7 +119,8 @@ public:
 
 private:
     explicit xml_stream(const xml_stream& parent, std::string closing, bool newl)
-    : closing_(closing), out_(parent.out_), newl_(newl), attributes_(parent.attributes_)
+    : closing_(closing), out_(parent.out_), resolver_(parent.resolver_), newl_(newl),
+      attributes_(parent.attributes_)
     {}
 
     void close()
@@ -129,9 +136,10 @@ private:
         }
     }
 
-    std::string                         closing_;
-    type_safe::object_ref<std::ostream> out_;
-    type_safe::flag                     newl_, attributes_;
+    std::string                                closing_;
+    type_safe::object_ref<std::ostream>        out_;
+    type_safe::object_ref<const link_resolver> resolver_;
+    type_safe::flag                            newl_, attributes_;
 };
 
 void write_entity(xml_stream& s, const entity& e);
@@ -444,27 +452,25 @@ void write(xml_stream& s, const external_link& link)
 
 void write(xml_stream& s, const documentation_link& link)
 {
-    if (link.internal_destination())
+    auto destination = link.destination(s.resolver());
+    if (auto internal = destination.optional_value(type_safe::variant_type<block_reference>{}))
     {
-        auto tag
-            = s.open_tag(xml_stream::inline_tag, "documentation-link",
-                         std::make_pair("title", link.title()),
-                         std::make_pair("destination-document",
-                                        link.internal_destination()
-                                            .value()
-                                            .document()
-                                            .value_or(output_name::from_name(""))
-                                            .name()),
-                         std::make_pair("destination-id",
-                                        link.internal_destination().value().id().as_output_str()));
+        auto tag = s.open_tag(xml_stream::inline_tag, "documentation-link",
+                              std::make_pair("title", link.title()),
+                              std::make_pair("destination-document",
+                                             internal.value()
+                                                 .document()
+                                                 .value_or(output_name::from_name(""))
+                                                 .name()),
+                              std::make_pair("destination-id",
+                                             internal.value().id().as_output_str()));
         write_children(tag, link);
     }
-    else if (link.external_destination())
+    else if (auto external = destination.optional_value(type_safe::variant_type<markup::url>{}))
     {
         auto tag = s.open_tag(xml_stream::inline_tag, "documentation-link",
                               std::make_pair("title", link.title()),
-                              std::make_pair("destination-url",
-                                             link.external_destination().value().as_str()));
+                              std::make_pair("destination-url", external.value().as_str()));
         write_children(tag, link);
     }
     else
@@ -553,16 +559,11 @@ void write_entity(xml_stream& s, const entity& e)
 }
 } // namespace
 
-generator standardese::markup::xml_generator(bool include_attributes) noexcept
+generator standardese::markup::xml_generator(bool          include_attributes,
+                                             link_resolver resolver) noexcept
 {
-    if (include_attributes)
-        return [](std::ostream& out, const entity& e) {
-            xml_stream s(type_safe::ref(out));
-            write_entity(s, e);
-        };
-    else
-        return [](std::ostream& out, const entity& e) {
-            xml_stream s(type_safe::ref(out), false);
-            write_entity(s, e);
-        };
+    return [include_attributes, resolver](std::ostream& out, const entity& e) {
+        xml_stream s(type_safe::ref(out), include_attributes, resolver);
+        write_entity(s, e);
+    };
 }
@@ -0,0 +1,194 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <standardese/profiler.hpp>
+
+#include <algorithm>
+
+#include <cppast/cpp_entity.hpp>
+#include <cppast/cpp_entity_kind.hpp>
+
+using namespace standardese;
+
+namespace
+{
+// the innermost scope of the current thread
+thread_local entity_profiler::scope* current_scope = nullptr;
+} // namespace
+
+entity_profiler& entity_profiler::get() noexcept
+{
+    static entity_profiler profiler;
+    return profiler;
+}
+
+void entity_profiler::enable(allocation_counter counter) noexcept
+{
+    counter_ = counter;
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void entity_profiler::disable()
+{
+    enabled_.store(false, std::memory_order_relaxed);
+    clear();
+}
+
+// the costs are recorded per thread, so the workers don't contend on the profiler's mutex,
+// they're merged when the thread exits or the costs are queried
+struct entity_profiler::thread_costs
+{
+    std::mutex mutex; // only contended while the costs are merged
+    cost_map   costs[_phase_count];
+
+    thread_costs()
+    {
+        auto&                       profiler = entity_profiler::get();
+        std::lock_guard<std::mutex> lock(profiler.mutex_);
+        profiler.threads_.push_back(this);
+    }
+
+    ~thread_costs()
+    {
+        auto&                       profiler = entity_profiler::get();
+        std::lock_guard<std::mutex> lock(profiler.mutex_);
+        profiler.merge(*this);
+
+        auto& threads = profiler.threads_;
+        threads.erase(std::find(threads.begin(), threads.end(), this));
+    }
+};
+
+entity_profiler::thread_costs& entity_profiler::get_thread_costs()
+{
+    thread_local thread_costs costs;
+    return costs;
+}
+
+void entity_profiler::merge(thread_costs& costs) const
+{
+    std::lock_guard<std::mutex> lock(costs.mutex);
+    for (auto p = 0; p != _phase_count; ++p)
+    {
+        for (auto& pair : costs.costs[p])
+        {
+            auto iter = costs_[p].find(pair.first);
+            if (iter == costs_[p].end())
+                costs_[p].emplace(pair.first, std::move(pair.second));
+            else
+            {
+                iter->second.seconds += pair.second.seconds;
+                iter->second.allocations += pair.second.allocations;
+            }
+        }
+        costs.costs[p].clear();
+    }
+}
+
+void entity_profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto thread : threads_)
+    {
+        std::lock_guard<std::mutex> thread_lock(thread->mutex);
+        for (auto& costs : thread->costs)
+            costs.clear();
+    }
+    for (auto& costs : costs_)
+        costs.clear();
+}
+
+std::vector<entity_profiler::cost> entity_profiler::most_expensive(phase p, std::size_t n) const
+{
+    std::vector<cost> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto thread : threads_)
+            merge(*thread);
+
+        result.reserve(costs_[p].size());
+        for (auto& pair : costs_[p])
+            result.push_back(pair.second);
+    }
+
+    auto by_seconds = [](const cost& a, const cost& b) { return a.seconds > b.seconds; };
+    if (result.size() > n)
+    {
+        std::partial_sort(result.begin(), result.begin() + std::ptrdiff_t(n), result.end(),
+                          by_seconds);
+        result.resize(n);
+    }
+    else
+        std::sort(result.begin(), result.end(), by_seconds);
+
+    return result;
+}
+
+std::string entity_profiler::get_location(const cppast::cpp_entity& entity)
+{
+    std::string name = entity.name(), file;
+    for (auto cur = entity.parent(); cur; cur = cur.value().parent())
+        if (cur.value().kind() == cppast::cpp_entity_kind::file_t)
+            file = cur.value().name();
+        else if (!cur.value().name().empty() && !cppast::is_template(cur.value().kind()))
+            // the template has the same name as the templated entity
+            name = cur.value().name() + "::" + name;
+
+    if (file.empty())
+        return name;
+    return file + ": " + name;
+}
+
+void entity_profiler::add(phase p, const cppast::cpp_entity& entity, double seconds,
+                          std::uint64_t allocations)
+{
+    auto&                       costs = get_thread_costs();
+    std::lock_guard<std::mutex> lock(costs.mutex);
+
+    // an entity can be processed multiple times in the same phase
+    auto iter = costs.costs[p].find(&entity);
+    if (iter == costs.costs[p].end())
+        costs.costs[p].emplace(&entity, cost{get_location(entity), seconds, allocations});
+    else
+    {
+        iter->second.seconds += seconds;
+        iter->second.allocations += allocations;
+    }
+}
+
+entity_profiler::scope::scope(phase p, type_safe::optional_ref<const cppast::cpp_entity> entity)
+: entity_(nullptr), parent_(nullptr), nested_time_(0), start_allocations_(0u),
+  nested_allocations_(0u), phase_(p)
+{
+    auto& profiler = entity_profiler::get();
+    if (!entity || !profiler.enabled())
+        return;
+
+    entity_            = &entity.value();
+    parent_            = current_scope;
+    current_scope      = this;
+    start_allocations_ = profiler.allocations();
+    start_             = clock::now();
+}
+
+entity_profiler::scope::~scope()
+{
+    if (!entity_)
+        return;
+
+    auto& profiler    = entity_profiler::get();
+    auto  time        = clock::now() - start_;
+    auto  allocations = profiler.allocations() - start_allocations_;
+
+    current_scope = parent_;
+    profiler.add(phase_, *entity_, std::chrono::duration<double>(time - nested_time_).count(),
+                 allocations - nested_allocations_);
+
+    if (parent_)
+    {
+        // measured after adding, so recording this scope isn't attributed to the parent either
+        parent_->nested_time_ += clock::now() - start_;
+        parent_->nested_allocations_ += profiler.allocations() - start_allocations_;
+    }
+}
@@ -6,6 +6,8 @@
 
 #include <catch.hpp>
 
+#include <cppast/cpp_function.hpp>
+
 #include "test_parser.hpp"
 
 using namespace standardese;
@@ -200,6 +202,82 @@ file - doc_entity__blacklisted.cpp
     entity - outer::a
 )");
     }
+    SECTION("blacklisted base")
+    {
+        entity_blacklist blacklist;
+        blacklist.blacklist_namespace("detail");
+
+        auto file = build_doc_entities(comments, {}, "doc_entity__blacklisted_base.cpp", R"(
+namespace detail
+{
+    /// Injected into foo.
+    struct base
+    {
+        void a();
+    };
+}
+
+struct foo : detail::base
+{
+    void b();
+};
+)",
+                                       blacklist);
+
+        REQUIRE(debug_string(*file) == R"(
+file - doc_entity__blacklisted_base.cpp
+  entity - foo
+    entity - detail::base::a()
+    entity - foo::b()
+)");
+    }
+    SECTION("pruned")
+    {
+        auto file = build_doc_entities(comments, {}, "doc_entity__pruned.cpp", R"(
+/// \exclude
+enum e
+{
+    a,
+    b
+};
+
+/// \exclude
+void f(int param);
+
+/// \exclude
+namespace ns
+{
+    void g();
+}
+
+/// \exclude
+struct base
+{
+    void h();
+};
+
+struct derived : base
+{
+    void i();
+};
+)");
+
+        REQUIRE(debug_string(*file) == R"(
+file - doc_entity__pruned.cpp
+  entity - derived
+    entity - base::h()
+    entity - derived::i()
+)");
+
+        // children that can't be injected aren't visited
+        REQUIRE(!get_named_entity(file->file(), "a").user_data());
+        auto& f = static_cast<const cppast::cpp_function&>(get_named_entity(file->file(), "f"));
+        REQUIRE(!f.parameters().begin()->user_data());
+
+        // but the ones of namespaces and classes are
+        REQUIRE(get_named_entity(file->file(), "g").user_data());
+        REQUIRE(get_named_entity(file->file(), "h").user_data());
+    }
     SECTION("member groups")
     {
         auto file = build_doc_entities(comments, {}, "doc_entity__member_groups", R"(
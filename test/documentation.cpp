@@ -569,11 +569,18 @@ namespace ns
         linker l;
         register_documentations(*test_logger(), l, *target_doc);
         register_documentations(*test_logger(), l, *doc);
+        l.freeze();
+
+        // resolving while rendering must not modify the document
+        auto render_resolved
+            = markup::render(markup::xml_generator(true, get_link_resolver(*test_logger(), l)),
+                             *doc);
 
         resolve_links(*test_logger(), l, *target_doc);
         resolve_links(*test_logger(), l, *doc);
 
         auto xml_doc = markup::as_xml(*doc);
+        REQUIRE(xml_doc == render_resolved);
         auto details = get_details(xml_doc);
         REQUIRE(details.size() == 3u);
 
@@ -274,3 +274,138 @@ TEST_CASE("module_index")
 )*";
     REQUIRE(markup::as_xml(*index.generate()) == xml);
 }
+
+TEST_CASE("excluded index entities")
+{
+    comment_registry         comments;
+    cppast::cpp_entity_index idx;
+    auto file = build_doc_entities(comments, idx, "index__excluded_entities.cpp", R"(
+/// \exclude
+namespace ns
+{
+    /// \module m
+    void a();
+}
+
+/// \exclude
+struct base
+{
+    /// \module m
+    void b();
+};
+
+/// \module m
+void c();
+)");
+
+    SECTION("entity_index")
+    {
+        entity_index index;
+        register_index_entities(index, file->file());
+
+        REQUIRE(markup::as_xml(*index.generate(entity_index::namespace_inline_sorted))
+                == R"*(<entity-index id="entity-index">
+<heading>Project index</heading>
+<entity-index-item id="c--">
+<entity><documentation-link unresolved-destination-id="c()"><code>c</code></documentation-link></entity>
+</entity-index-item>
+</entity-index>
+)*");
+    }
+    SECTION("module_index")
+    {
+        module_index index;
+        register_module_entities(index, comments, file->file());
+
+        REQUIRE(markup::as_xml(*index.generate()) == R"*(<module-index id="module-index">
+<heading>Project modules</heading>
+<module-documentation id="m">
+<heading>Module <code>m</code></heading>
+<entity-index-item id="c--">
+<entity><documentation-link unresolved-destination-id="c()"><code>c</code></documentation-link></entity>
+</entity-index-item>
+</module-documentation>
+</module-index>
+)*");
+    }
+}
+
+TEST_CASE("injected module entities")
+{
+    comment_registry         comments;
+    cppast::cpp_entity_index idx;
+
+    // members of excluded bases are part of the module through the derived class
+    SECTION("excluded base")
+    {
+        auto file = build_doc_entities(comments, idx, "index__injected_excluded.cpp", R"(
+/// \exclude
+struct base
+{
+    /// \module m
+    void b();
+};
+
+struct derived : base
+{
+    /// \module m
+    void c();
+};
+)");
+
+        module_index index;
+        register_module_entities(index, comments, file->file());
+        REQUIRE(markup::as_xml(*index.generate()) == R"*(<module-index id="module-index">
+<heading>Project modules</heading>
+<module-documentation id="m">
+<heading>Module <code>m</code></heading>
+<entity-index-item id="base__b--">
+<entity><documentation-link unresolved-destination-id="base::b()"><code>b</code></documentation-link></entity>
+</entity-index-item>
+<entity-index-item id="derived__c--">
+<entity><documentation-link unresolved-destination-id="derived::c()"><code>c</code></documentation-link></entity>
+</entity-index-item>
+</module-documentation>
+</module-index>
+)*");
+    }
+    SECTION("blacklisted base")
+    {
+        entity_blacklist blacklist;
+        blacklist.blacklist_namespace("detail");
+
+        auto file = build_doc_entities(comments, idx, "index__injected_blacklisted.cpp", R"(
+namespace detail
+{
+    struct base
+    {
+        /// \module m
+        void b();
+    };
+}
+
+struct derived : detail::base
+{
+    /// \module m
+    void c();
+};
+)",
+                                       blacklist);
+
+        module_index index;
+        register_module_entities(index, comments, file->file());
+        REQUIRE(markup::as_xml(*index.generate()) == R"*(<module-index id="module-index">
+<heading>Project modules</heading>
+<module-documentation id="m">
+<heading>Module <code>m</code></heading>
+<entity-index-item id="detail__base__b--">
+<entity><documentation-link unresolved-destination-id="detail::base::b()"><code>b</code></documentation-link></entity>
+</entity-index-item>
+<entity-index-item id="derived__c--">
+<entity><documentation-link unresolved-destination-id="derived::c()"><code>c</code></documentation-link></entity>
+</entity-index-item>
+</module-documentation>
+</module-index>
+)*");
+    }
+}
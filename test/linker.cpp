@@ -147,6 +147,43 @@ void context3();
         REQUIRE(equal_destination(l.lookup_documentation(type_safe::ref(context3), "*func"),
                                   *document_a, markup::block_id("func")));
     }
+    SECTION("excluded entities")
+    {
+        comment_registry         comments;
+        cppast::cpp_entity_index index;
+        auto file = build_doc_entities(comments, index, "linker__excluded_entities.cpp", R"(
+/// \exclude
+namespace ns
+{
+    void a();
+}
+
+/// \exclude
+struct base
+{
+    void b();
+};
+
+struct derived : base
+{
+    void c();
+};
+)");
+
+        auto doc = markup::main_document::builder("doc", "doc")
+                       .add_child(generate_documentation({}, {}, index, *file))
+                       .finish();
+        register_documentations(*test_logger(), l, *doc);
+        l.freeze();
+
+        REQUIRE(!l.lookup_documentation(nullptr, "ns"));
+        REQUIRE(!l.lookup_documentation(nullptr, "ns::a()"));
+        REQUIRE(!l.lookup_documentation(nullptr, "base"));
+        REQUIRE(l.lookup_documentation(nullptr, "derived::c()").has_value());
+
+        // injected members are linked through the derived class
+        REQUIRE(l.lookup_documentation(nullptr, "base::b()").has_value());
+    }
     SECTION("external doc")
     {
         l.register_external("std", "std/$$/");
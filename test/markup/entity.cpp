@@ -0,0 +1,81 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <standardese/markup/entity.hpp>
+
+#include <catch.hpp>
+
+#include <standardese/markup/paragraph.hpp>
+#include <standardese/markup/phrasing.hpp>
+
+using namespace standardese::markup;
+
+namespace
+{
+// reserve is called with reserve_n when reserve_after children have been added
+std::unique_ptr<paragraph> build_paragraph(std::size_t n, std::size_t reserve_after = 0u,
+                                           std::size_t reserve_n = 0u)
+{
+    paragraph::builder builder;
+    for (auto i = 0u; i <= n; ++i)
+    {
+        if (reserve_n > 0u && i == reserve_after)
+            builder.reserve(reserve_n);
+        if (i != n)
+            builder.add_child(text::build(std::to_string(i)));
+    }
+    return builder.finish();
+}
+
+void check_children(const paragraph& p, std::size_t n)
+{
+    REQUIRE(p.size() == n);
+
+    auto i = 0u;
+    for (auto& child : p)
+    {
+        REQUIRE(child.kind() == entity_kind::text);
+        REQUIRE(static_cast<const text&>(child).string() == std::to_string(i));
+        REQUIRE(&child.parent().value() == &p);
+        ++i;
+    }
+    REQUIRE(i == n);
+
+    auto clone = p.clone();
+    REQUIRE(clone->kind() == entity_kind::paragraph);
+    REQUIRE(static_cast<const paragraph&>(*clone).size() == n);
+}
+} // namespace
+
+TEST_CASE("container_entity", "[markup]")
+{
+    // the first three children are stored inline
+    for (auto n : {0u, 3u, 4u, 7u})
+    {
+        SECTION("without reserve " + std::to_string(n))
+        {
+            check_children(*build_paragraph(n), n);
+        }
+        SECTION("reserve upfront " + std::to_string(n))
+        {
+            check_children(*build_paragraph(n, 0u, n), n);
+        }
+    }
+    SECTION("reserve while inline")
+    {
+        check_children(*build_paragraph(7u, 2u, 7u), 7u);
+        check_children(*build_paragraph(4u, 3u, 4u), 4u);
+        check_children(*build_paragraph(3u, 1u, 2u), 3u);
+    }
+    SECTION("reserve too little")
+    {
+        check_children(*build_paragraph(7u, 0u, 5u), 7u);
+        check_children(*build_paragraph(7u, 2u, 4u), 7u);
+    }
+    SECTION("reserve while on heap")
+    {
+        check_children(*build_paragraph(7u, 5u, 6u), 7u);
+        check_children(*build_paragraph(7u, 4u, 20u), 7u);
+    }
+}
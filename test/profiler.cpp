@@ -0,0 +1,122 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <standardese/profiler.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <thread>
+
+#include "test_parser.hpp"
+
+using namespace standardese;
+
+namespace
+{
+// enables the profiler while alive, so other tests aren't affected
+class enable_profiler
+{
+public:
+    enable_profiler()
+    {
+        entity_profiler::get().enable();
+        entity_profiler::get().clear();
+    }
+
+    enable_profiler(const enable_profiler&) = delete;
+    enable_profiler& operator=(const enable_profiler&) = delete;
+
+    ~enable_profiler()
+    {
+        entity_profiler::get().disable();
+    }
+};
+} // namespace
+
+TEST_CASE("entity_profiler")
+{
+    enable_profiler guard;
+    auto&           profiler = entity_profiler::get();
+
+    comment_registry         comments;
+    cppast::cpp_entity_index index;
+
+    auto file = build_doc_entities(comments, index, "profiler.hpp", R"(
+namespace ns
+{
+    /// A class.
+    struct foo
+    {
+        /// A member function.
+        void bar();
+    };
+}
+)");
+    generate_documentation({}, {}, index, *file);
+
+    auto get_locations = [&](entity_profiler::phase p) {
+        auto costs = profiler.most_expensive(p, 100u);
+        REQUIRE(std::is_sorted(costs.begin(), costs.end(),
+                               [](const entity_profiler::cost& a, const entity_profiler::cost& b) {
+                                   return a.seconds > b.seconds;
+                               }));
+
+        std::vector<std::string> result;
+        for (auto& cost : costs)
+        {
+            // no allocation counter given
+            REQUIRE(cost.allocations == 0u);
+            result.push_back(cost.location);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+
+    SECTION("comment parse")
+    {
+        auto locations = get_locations(entity_profiler::comment_parse);
+        REQUIRE(std::count(locations.begin(), locations.end(), "profiler.hpp: ns::foo") == 1);
+        REQUIRE(std::count(locations.begin(), locations.end(), "profiler.hpp: ns::foo::bar") == 1);
+    }
+    SECTION("synopsis")
+    {
+        auto locations = get_locations(entity_profiler::synopsis);
+        REQUIRE(std::count(locations.begin(), locations.end(), "profiler.hpp: ns::foo") == 1);
+        REQUIRE(std::count(locations.begin(), locations.end(), "profiler.hpp: ns::foo::bar") == 1);
+    }
+    SECTION("documentation")
+    {
+        auto locations = get_locations(entity_profiler::documentation);
+        REQUIRE(std::count(locations.begin(), locations.end(), "profiler.hpp") == 1);
+        REQUIRE(std::count(locations.begin(), locations.end(), "profiler.hpp: ns::foo") == 1);
+        REQUIRE(std::count(locations.begin(), locations.end(), "profiler.hpp: ns::foo::bar") == 1);
+    }
+    SECTION("threads")
+    {
+        // the costs of a thread are merged with the others once it exits
+        std::thread thread([&] { generate_documentation({}, {}, index, *file); });
+        thread.join();
+
+        auto costs = profiler.most_expensive(entity_profiler::documentation, 100u);
+        REQUIRE(std::count_if(costs.begin(), costs.end(), [](const entity_profiler::cost& c) {
+                    return c.location == "profiler.hpp: ns::foo::bar";
+                })
+                == 1);
+    }
+    SECTION("top")
+    {
+        REQUIRE(profiler.most_expensive(entity_profiler::documentation, 2u).size() == 2u);
+    }
+    SECTION("destroyed entities")
+    {
+        file.reset();
+        // the locations are captured when recorded
+        auto costs = profiler.most_expensive(entity_profiler::synopsis, 100u);
+        REQUIRE(std::count_if(costs.begin(), costs.end(), [](const entity_profiler::cost& c) {
+                    return c.location == "profiler.hpp: ns::foo";
+                })
+                == 1);
+    }
+}
@@ -55,10 +55,11 @@ inline const standardese::doc_entity& get_named_entity(const standardese::doc_cp
     return *static_cast<const standardese::doc_entity*>(cpp_entity.user_data());
 }
 
-inline standardese::comment_registry parse_comments(const cppast::cpp_file& file)
+inline standardese::comment_registry parse_comments(
+    const cppast::cpp_file& file, const standardese::entity_blacklist& blacklist = {})
 {
     standardese::file_comment_parser parser(test_logger());
-    parser.parse(type_safe::ref(file));
+    parser.parse(type_safe::ref(file), blacklist);
     return parser.finish();
 }
 
@@ -77,7 +78,7 @@ inline std::unique_ptr<standardese::doc_cpp_file> build_doc_entities(
     const char* name, const char* source, const standardese::entity_blacklist& blacklist = {})
 {
     auto file = parse_file(index, name, source);
-    comments.merge(parse_comments(*file));
+    comments.merge(parse_comments(*file, blacklist));
     return build_doc_entities(comments, index, std::move(file), blacklist);
 }
 
@@ -0,0 +1,84 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "allocations.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+// constant initialized, so it can be used by allocations during static initialization
+std::atomic<bool>          counting(false);
+thread_local std::uint64_t allocations = 0u;
+} // namespace
+
+void standardese_tool::count_allocations() noexcept
+{
+    counting.store(true, std::memory_order_relaxed);
+}
+
+std::uint64_t standardese_tool::thread_allocations()
+{
+    return allocations;
+}
+
+void* operator new(std::size_t size)
+{
+    if (counting.load(std::memory_order_relaxed))
+        ++allocations;
+    while (true)
+    {
+        if (auto ptr = std::malloc(size == 0u ? 1u : size))
+            return ptr;
+
+        auto handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return ::operator new(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    ::operator delete(ptr);
+}
@@ -0,0 +1,22 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_TOOL_ALLOCATIONS_HPP_INCLUDED
+#define STANDARDESE_TOOL_ALLOCATIONS_HPP_INCLUDED
+
+#include <cstdint>
+
+namespace standardese_tool
+{
+/// \effects Starts counting the allocations.
+/// \notes The tool always replaces the global `operator new`,
+/// but it only counts allocations after this function has been called.
+void count_allocations() noexcept;
+
+/// \returns The number of allocations done by the calling thread
+/// since [standardese_tool::count_allocations]() has been called.
+std::uint64_t thread_allocations();
+} // namespace standardese_tool
+
+#endif // STANDARDESE_TOOL_ALLOCATIONS_HPP_INCLUDED
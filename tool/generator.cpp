@@ -6,29 +6,166 @@
 
 #include <fstream>
 
+#include <cppast/visitor.hpp>
+
+#include <standardese/detail/probe.hpp>
 #include <standardese/index.hpp>
 #include <standardese/linker.hpp>
+#include <standardese/markup/link.hpp>
+#include <standardese/markup/visitor.hpp>
 
 #include "thread_pool.hpp"
 
 using namespace standardese_tool;
 
+namespace
+{
+#if defined(STANDARDESE_HAS_USDT) && STANDARDESE_HAS_USDT
+// fires the USDT probes at the start and end of a phase
+class phase_probe
+{
+public:
+    explicit phase_probe(const char* name) : name_(name)
+    {
+        STANDARDESE_PROBE1(phase__start, name_);
+    }
+
+    phase_probe(const phase_probe&) = delete;
+    phase_probe& operator=(const phase_probe&) = delete;
+
+    ~phase_probe()
+    {
+        STANDARDESE_PROBE1(phase__end, name_);
+    }
+
+private:
+    const char* name_;
+};
+
+// fires the USDT probes at the start and end of a job
+class job_probe
+{
+public:
+    job_probe(const char* phase, const char* file) : phase_(phase), file_(file)
+    {
+        STANDARDESE_PROBE2(job__start, phase_, file_);
+    }
+
+    job_probe(const job_probe&) = delete;
+    job_probe& operator=(const job_probe&) = delete;
+
+    ~job_probe()
+    {
+        STANDARDESE_PROBE2(job__end, phase_, file_);
+    }
+
+private:
+    const char* phase_;
+    const char* file_;
+};
+
+// forwards to another buffer and counts the bytes written,
+// as querying the position of a file stream is a syscall
+class counting_buffer : public std::streambuf
+{
+public:
+    explicit counting_buffer(std::streambuf& buffer) : buffer_(&buffer), count_(0)
+    {
+        setp(data_, data_ + sizeof(data_));
+    }
+
+    long long count() const noexcept
+    {
+        return count_ + (pptr() - pbase());
+    }
+
+private:
+    int_type overflow(int_type c) override
+    {
+        if (write() == -1)
+            return traits_type::eof();
+        else if (!traits_type::eq_int_type(c, traits_type::eof()))
+            sputc(traits_type::to_char_type(c));
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override
+    {
+        return write() == -1 ? -1 : buffer_->pubsync();
+    }
+
+    int write()
+    {
+        auto size = pptr() - pbase();
+        if (buffer_->sputn(pbase(), size) != size)
+            return -1;
+
+        count_ += size;
+        setp(data_, data_ + sizeof(data_));
+        return 0;
+    }
+
+    std::streambuf* buffer_;
+    long long       count_;
+    char            data_[4096];
+};
+
+void write_file(const standardese::markup::generator& generator, const std::string& file_name,
+                const standardese::markup::document_entity& doc)
+{
+    std::ofstream   file(file_name);
+    counting_buffer buffer(*file.rdbuf());
+    std::ostream    out(&buffer);
+
+    STANDARDESE_PROBE1(file__write__start, file_name.c_str());
+    generator(out, doc);
+    out.flush();
+    STANDARDESE_PROBE2(file__write__end, file_name.c_str(), buffer.count());
+}
+#else
+class phase_probe
+{
+public:
+    explicit phase_probe(const char*) noexcept {}
+};
+
+class job_probe
+{
+public:
+    job_probe(const char*, const char*) noexcept {}
+};
+
+void write_file(const standardese::markup::generator& generator, const std::string& file_name,
+                const standardese::markup::document_entity& doc)
+{
+    std::ofstream file(file_name);
+    generator(file, doc);
+}
+#endif
+} // namespace
+
 type_safe::optional<std::vector<parsed_file>> standardese_tool::parse(
     const cppast::libclang_compile_config&                            config,
     const type_safe::optional<cppast::libclang_compilation_database>& database,
     const std::vector<input_file>& files, const cppast::cpp_entity_index& index,
-    unsigned no_threads)
+    unsigned no_threads, progress_reporter& progress)
 {
     std::vector<parsed_file> result;
     bool                     error(false);
-    cppast::libclang_parser  parser(cppast::default_logger());
+    cppast::libclang_parser  parser(type_safe::ref(progress.logger()));
 
+    progress.begin_phase("parse", files.size());
     {
+        phase_probe probe("parse");
         std::mutex  mutex;
         thread_pool pool(no_threads);
         for (auto& file : files)
         {
             add_job(pool, [&, file] {
+                auto      name = file.relative.generic_string();
+                job_probe job_probe("parse", name.c_str());
+                auto      job = progress.start_job(name);
+
                 auto db_config = database.map([&](const cppast::libclang_compilation_database& db) {
                     return cppast::find_config_for(db, file.path.generic_string());
                 });
@@ -36,15 +173,28 @@ type_safe::optional<std::vector<parsed_file>> standardese_tool::parse(
                 auto actual_config = db_config.value_or(config);
                 auto parsed
                     = parser.parse(index, fs::canonical(file.path).generic_string(), actual_config);
+                std::size_t count = 0u;
+                if (parsed && progress.reports_progress())
+                {
+                    cppast::visit(*parsed, [&](const cppast::cpp_entity&,
+                                               const cppast::visitor_info& info) {
+                        if (info.event != cppast::visitor_info::container_entity_exit)
+                            ++count;
+                        return true;
+                    });
+                    job.set_entity_count(count);
+                }
 
                 std::lock_guard<std::mutex> lock(mutex);
                 if (parsed)
-                    result.push_back({std::move(parsed), file.relative.generic_string()});
+                    // not moved, the name is still needed by the probe
+                    result.push_back({std::move(parsed), name, count});
                 else
                     error = true;
             });
         }
     }
+    progress.end_phase();
 
     if (error)
         return type_safe::nullopt;
@@ -54,44 +204,63 @@ type_safe::optional<std::vector<parsed_file>> standardese_tool::parse(
 
 standardese::comment_registry standardese_tool::parse_comments(
     const standardese::comment::config& config, const std::vector<parsed_file>& files,
-    unsigned no_threads)
+    const standardese::entity_blacklist& blacklist, unsigned no_threads,
+    progress_reporter& progress)
 {
-    standardese::file_comment_parser parser(cppast::default_logger(), config);
+    standardese::file_comment_parser parser(type_safe::ref(progress.logger()), config);
+    progress.begin_phase("comment parse", files.size());
     {
+        phase_probe probe("comment parse");
         thread_pool pool(no_threads);
         for (auto& file : files)
-            add_job(pool, [&file, &parser] { parser.parse(type_safe::ref(*file.file)); });
+            add_job(pool, [&file, &parser, &blacklist, &progress] {
+                job_probe job_probe("comment parse", file.output_name.c_str());
+                auto      job = progress.start_job(file.output_name, file.entity_count);
+                parser.parse(type_safe::ref(*file.file), blacklist);
+            });
     }
+    progress.end_phase();
     return parser.finish();
 }
 
-std::vector<std::unique_ptr<standardese::doc_cpp_file>> standardese_tool::build_files(
+std::vector<built_file> standardese_tool::build_files(
     const standardese::comment_registry& registry, const cppast::cpp_entity_index& index,
     std::vector<parsed_file>&& files, const standardese::entity_blacklist& blacklist,
-    unsigned no_threads)
+    unsigned no_threads, progress_reporter& progress)
 {
+    progress.begin_phase("exclude", files.size());
     {
+        phase_probe probe("exclude");
         thread_pool pool(no_threads);
         for (auto& file : files)
-            add_job(pool,
-                    [&] { standardese::exclude_entities(registry, index, blacklist, *file.file); });
+            add_job(pool, [&] {
+                job_probe job_probe("exclude", file.output_name.c_str());
+                auto      job = progress.start_job(file.output_name, file.entity_count);
+                standardese::exclude_entities(registry, index, blacklist, *file.file);
+            });
     }
 
-    std::vector<std::unique_ptr<standardese::doc_cpp_file>> result;
+    std::vector<built_file> result;
 
+    progress.begin_phase("build", files.size());
     {
+        phase_probe probe("build");
         std::mutex  mutex;
         thread_pool pool(no_threads);
         for (auto& file : files)
             add_job(pool, [&] {
+                job_probe job_probe("build", file.output_name.c_str());
+                auto      job = progress.start_job(file.output_name, file.entity_count);
+                // not moved, the name is still needed by the probe
                 auto entity = standardese::build_doc_entities(type_safe::ref(registry), index,
                                                               std::move(file.file),
-                                                              std::move(file.output_name));
+                                                              file.output_name);
 
                 std::lock_guard<std::mutex> lock(mutex);
-                result.push_back(std::move(entity));
+                result.push_back({std::move(entity), file.entity_count});
             });
     }
+    progress.end_phase();
 
     return result;
 }
@@ -111,21 +280,27 @@ documents standardese_tool::generate(
     const standardese::generation_config& gen_config,
     const standardese::synopsis_config& syn_config, const standardese::comment_registry& comments,
     const cppast::cpp_entity_index& index, const standardese::linker& linker,
-    const std::vector<std::unique_ptr<standardese::doc_cpp_file>>& files, unsigned no_threads)
+    const std::vector<built_file>& files, unsigned no_threads, progress_reporter& progress)
 {
-    std::mutex                                                         result_mutex;
-    std::vector<std::unique_ptr<standardese::markup::document_entity>> result;
+    std::mutex result_mutex;
+    documents  result;
 
     standardese::entity_index eindex;
     standardese::file_index   findex;
     standardese::module_index mindex;
 
+    progress.begin_phase("generate", files.size());
     {
+        phase_probe probe("generate");
         thread_pool pool(no_threads);
 
         std::vector<std::future<void>> futures;
-        for (auto& file : files)
+        for (auto& built : files)
             futures.push_back(add_job(pool, [&] {
+                auto&     file = built.file;
+                job_probe job_probe("generate", file->output_name().c_str());
+                auto      job = progress.start_job(file->output_name(), built.entity_count);
+
                 standardese::markup::subdocument::builder document(file->output_name(),
                                                                    "doc_"
                                                                        + get_output_file_name(
@@ -134,8 +309,7 @@ documents standardese_tool::generate(
                     standardese::generate_documentation(gen_config, syn_config, index, *file));
                 auto finished_doc = document.finish();
 
-                standardese::register_documentations(*cppast::default_logger(), linker,
-                                                     *finished_doc);
+                standardese::register_documentations(progress.logger(), linker, *finished_doc);
                 standardese::register_index_entities(eindex, file->file());
                 standardese::register_module_entities(mindex, comments, file->file());
                 findex.register_file(file->link_name(), file->output_name(),
@@ -143,39 +317,66 @@ documents standardese_tool::generate(
                                                      : nullptr);
 
                 std::lock_guard<std::mutex> lock(result_mutex);
-                result.push_back(std::move(finished_doc));
+                result.push_back({std::move(finished_doc), built.entity_count});
             }));
 
         for (auto& future : futures)
             future.get(); // to retrieve exceptions
     }
+    progress.end_phase();
 
     auto eindex_doc = get_index_document(eindex.generate(gen_config.order()), "Entities",
                                          "standardese_entities");
-    standardese::register_documentations(*cppast::default_logger(), linker, *eindex_doc);
-    result.push_back(std::move(eindex_doc));
+    standardese::register_documentations(progress.logger(), linker, *eindex_doc);
+    result.push_back({std::move(eindex_doc), 0u});
 
     auto findex_doc = get_index_document(findex.generate(), "Files", "standardese_files");
-    standardese::register_documentations(*cppast::default_logger(), linker, *findex_doc);
-    result.push_back(std::move(findex_doc));
+    standardese::register_documentations(progress.logger(), linker, *findex_doc);
+    result.push_back({std::move(findex_doc), 0u});
 
     auto mindex_doc = get_index_document(mindex.generate(), "Modules", "standardese_modules");
-    standardese::register_documentations(*cppast::default_logger(), linker, *mindex_doc);
-    result.push_back(std::move(mindex_doc));
+    standardese::register_documentations(progress.logger(), linker, *mindex_doc);
+    result.push_back({std::move(mindex_doc), 0u});
 
-    for (auto& doc : result)
-        standardese::resolve_links(*cppast::default_logger(), linker, *doc);
+    // links are resolved while writing the files
+    linker.freeze();
 
     return result;
 }
 
-void standardese_tool::write_files(const documents& docs, standardese::markup::generator generator,
-                                   std::string prefix, const char* extension, unsigned no_threads)
+void standardese_tool::check_links(const documents& docs, const standardese::linker& linker)
 {
-    thread_pool pool(no_threads);
+    auto resolver = standardese::get_link_resolver(*cppast::default_logger(), linker);
     for (auto& doc : docs)
-        add_job(pool, [&] {
-            std::ofstream file(prefix + doc->output_name().file_name(extension));
-            generator(file, *doc);
+        standardese::markup::visit(*doc.doc, [&](const standardese::markup::entity& entity) {
+            if (entity.kind() != standardese::markup::entity_kind::documentation_link)
+                return;
+
+            auto& link = static_cast<const standardese::markup::documentation_link&>(entity);
+            if (link.unresolved_destination())
+                // result is not needed, only the diagnostic
+                resolver(link);
         });
 }
+
+void standardese_tool::write_files(const documents& docs, standardese::markup::generator generator,
+                                   std::string prefix, const char* extension, unsigned no_threads,
+                                   progress_reporter& progress)
+{
+    auto phase = std::string("write ") + extension;
+    progress.begin_phase(phase, docs.size());
+    {
+        phase_probe probe(phase.c_str());
+        thread_pool pool(no_threads);
+        for (auto& document : docs)
+            add_job(pool, [&] {
+                auto&     doc = document.doc;
+                job_probe job_probe(phase.c_str(), doc->output_name().name().c_str());
+                auto      job
+                    = progress.start_job(doc->output_name().name(), document.entity_count);
+
+                write_file(generator, prefix + doc->output_name().file_name(extension), *doc);
+            });
+    }
+    progress.end_phase();
+}
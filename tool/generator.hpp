@@ -18,6 +18,7 @@
 #include <standardese/markup/generator.hpp>
 
 #include "filesystem.hpp"
+#include "progress.hpp"
 
 namespace standardese_tool
 {
@@ -31,34 +32,55 @@ struct parsed_file
 {
     std::unique_ptr<cppast::cpp_file> file;
     std::string                       output_name;
+    // weight of the jobs processing the file, only counted if the progress is reported
+    std::size_t entity_count;
 };
 
 type_safe::optional<std::vector<parsed_file>> parse(
     const cppast::libclang_compile_config&                            config,
     const type_safe::optional<cppast::libclang_compilation_database>& database,
     const std::vector<input_file>& files, const cppast::cpp_entity_index& index,
-    unsigned no_threads);
+    unsigned no_threads, progress_reporter& progress);
 
-standardese::comment_registry parse_comments(const standardese::comment::config& config,
-                                             const std::vector<parsed_file>&     files,
-                                             unsigned                            no_threads);
+standardese::comment_registry parse_comments(const standardese::comment::config&  config,
+                                             const std::vector<parsed_file>&      files,
+                                             const standardese::entity_blacklist& blacklist,
+                                             unsigned                             no_threads,
+                                             progress_reporter&                   progress);
 
-std::vector<std::unique_ptr<standardese::doc_cpp_file>> build_files(
-    const standardese::comment_registry& registry, const cppast::cpp_entity_index& index,
-    std::vector<parsed_file>&& files, const standardese::entity_blacklist& blacklist,
-    unsigned no_threads);
+struct built_file
+{
+    std::unique_ptr<standardese::doc_cpp_file> file;
+    std::size_t                                entity_count;
+};
 
-using documents = std::vector<std::unique_ptr<standardese::markup::document_entity>>;
+std::vector<built_file> build_files(const standardese::comment_registry& registry,
+                                    const cppast::cpp_entity_index&      index,
+                                    std::vector<parsed_file>&&           files,
+                                    const standardese::entity_blacklist& blacklist,
+                                    unsigned no_threads, progress_reporter& progress);
+
+struct document
+{
+    std::unique_ptr<standardese::markup::document_entity> doc;
+    std::size_t                                           entity_count;
+};
+
+using documents = std::vector<document>;
 
 documents generate(const standardese::generation_config& gen_config,
                    const standardese::synopsis_config&   syn_config,
                    const standardese::comment_registry&  comments,
                    const cppast::cpp_entity_index& index, const standardese::linker& linker,
-                   const std::vector<std::unique_ptr<standardese::doc_cpp_file>>& files,
-                   unsigned                                                       no_threads);
+                   const std::vector<built_file>& files, unsigned no_threads,
+                   progress_reporter& progress);
+
+// reports all links that can't be resolved, without resolving them
+void check_links(const documents& docs, const standardese::linker& linker);
 
 void write_files(const documents& docs, standardese::markup::generator generator,
-                 std::string prefix, const char* extension, unsigned no_threads);
+                 std::string prefix, const char* extension, unsigned no_threads,
+                 progress_reporter& progress);
 } // namespace standardese_tool
 
 #endif // STANDARDESE_TOOL_GENERATOR_HPP_INCLUDED
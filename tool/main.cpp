@@ -3,12 +3,19 @@
 // found in the top-level directory of this distribution.
 
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 
 #include <boost/program_options.hpp>
 
+#include <cppast/diagnostic_logger.hpp>
+
+#include <standardese/profiler.hpp>
+
+#include "allocations.hpp"
 #include "filesystem.hpp"
 #include "generator.hpp"
+#include "progress.hpp"
 #include "thread_pool.hpp"
 
 namespace po = boost::program_options;
@@ -241,32 +248,56 @@ standardese::generation_config get_generation_config(const po::variables_map& op
     return config;
 }
 
+// used for all but the first resolving format, so unresolved links are only reported once
+class quiet_logger : public cppast::diagnostic_logger
+{
+    bool do_log(const char*, const cppast::diagnostic&) const override
+    {
+        return false;
+    }
+};
+
+// reports_links is set to whether or not one of the formats reports unresolved links
 std::vector<std::pair<standardese::markup::generator, const char*>> get_formats(
-    const po::variables_map& options)
+    const po::variables_map& options, const standardese::linker& linker,
+    const cppast::diagnostic_logger& logger, bool& reports_links)
 {
+    static const quiet_logger quiet;
+
     std::vector<std::pair<standardese::markup::generator, const char*>> formats;
 
     auto link_prefix    = get_option<std::string>(options, "output.link_prefix").value_or("");
     auto link_extension = get_option<std::string>(options, "output.link_extension");
 
+    reports_links     = false;
+    auto get_resolver = [&] {
+        auto& format_logger
+            = reports_links ? static_cast<const cppast::diagnostic_logger&>(quiet) : logger;
+        reports_links = true;
+        return standardese::get_link_resolver(format_logger, linker);
+    };
+
     auto option = get_option<std::vector<std::string>>(options, "output.format").value();
     for (auto& format : option)
         if (format == "html")
             formats.emplace_back(standardese::markup::html_generator(link_prefix,
                                                                      link_extension.value_or(
-                                                                         "html")),
+                                                                         "html"),
+                                                                     get_resolver()),
                                  "html");
         else if (format == "xml")
-            formats.emplace_back(standardese::markup::xml_generator(), "xml");
+            formats.emplace_back(standardese::markup::xml_generator(true, get_resolver()), "xml");
         else if (format == "commonmark")
             formats.emplace_back(standardese::markup::markdown_generator(false, link_prefix,
                                                                          link_extension.value_or(
-                                                                             "md")),
+                                                                             "md"),
+                                                                         get_resolver()),
                                  "md");
         else if (format == "commonmark_html")
             formats.emplace_back(standardese::markup::markdown_generator(true, link_prefix,
                                                                          link_extension.value_or(
-                                                                             "md")),
+                                                                             "md"),
+                                                                         get_resolver()),
                                  "md");
         else if (format == "text")
             formats.emplace_back(standardese::markup::text_generator(), "txt");
@@ -289,6 +320,42 @@ standardese::entity_blacklist get_blacklist(const po::variables_map& options)
     return blacklist;
 }
 
+std::unique_ptr<standardese_tool::progress_reporter> get_progress_reporter(
+    const po::variables_map& options, unsigned no_threads)
+{
+    using standardese_tool::progress_reporter;
+
+    auto report_progress = get_option<bool>(options, "progress").value();
+    auto perf_counters   = get_option<bool>(options, "perf-counters").value();
+    if (!report_progress && !perf_counters)
+        return std::unique_ptr<progress_reporter>(new progress_reporter());
+
+    auto mode    = report_progress ? progress_reporter::default_output_mode()
+                                   : progress_reporter::output_mode::none;
+    auto timings = get_option<std::string>(options, "progress-timings").value_or("");
+    return std::unique_ptr<progress_reporter>(
+        new progress_reporter(mode, std::move(timings), no_threads, perf_counters));
+}
+
+void print_entity_costs(std::size_t n)
+{
+    using standardese::entity_profiler;
+
+    static const char* const phase_names[] = {"comment parsing", "synopsis generation",
+                                              "documentation generation"};
+    for (auto phase = 0; phase != entity_profiler::_phase_count; ++phase)
+    {
+        auto costs = entity_profiler::get().most_expensive(entity_profiler::phase(phase), n);
+        if (costs.empty())
+            continue;
+
+        std::clog << "most expensive entities in " << phase_names[phase] << ":\n";
+        for (auto& cost : costs)
+            std::clog << "    " << std::fixed << std::setprecision(3) << cost.seconds * 1000.
+                      << "ms, " << cost.allocations << " allocations - " << cost.location << '\n';
+    }
+}
+
 void register_external_documentations(standardese::linker& l, const po::variables_map& options)
 {
     l.register_external("std", "http://en.cppreference.com/mwiki/"
@@ -318,7 +385,15 @@ int main(int argc, char* argv[])
         ("verbose,v", po::value<bool>()->implicit_value(true)->default_value(false),
          "prints more information")
         ("jobs,j", po::value<unsigned>()->default_value(standardese_tool::default_no_threads()),
-         "sets the number of threads to use");
+         "sets the number of threads to use")
+        ("progress", po::value<bool>()->implicit_value(true)->default_value(false),
+         "reports the progress of each phase, as a status line on stderr or as JSON lines on stdout if stderr is not a terminal")
+        ("progress-timings", po::value<std::string>(),
+         "file where the timings of a run are stored, they are used to estimate the remaining time of the next run")
+        ("perf-counters", po::value<bool>()->implicit_value(true)->default_value(false),
+         "records hardware performance counters (cycles, instructions, cache and branch misses) per phase and thread, requires perf_event_open()")
+        ("entity-costs", po::value<unsigned>()->implicit_value(10u)->default_value(0u),
+         "reports the given number of entities that took the most time in comment parsing, synopsis and documentation generation");
 
     configuration.add_options()
         ("input.source_ext",
@@ -439,32 +514,50 @@ int main(int argc, char* argv[])
 
             auto blacklist = get_blacklist(options);
 
-            auto formats = get_formats(options);
-            auto prefix  = get_option<std::string>(options, "output.prefix").value();
-
             standardese::linker linker;
             register_external_documentations(linker, options);
 
+            auto progress = get_progress_reporter(options, no_threads);
+
+            // links are resolved while the files are written, with the status line active
+            auto reports_links = false;
+            auto formats = get_formats(options, linker, progress->logger(), reports_links);
+            auto prefix  = get_option<std::string>(options, "output.prefix").value();
+
+            auto entity_costs = get_option<unsigned>(options, "entity-costs").value();
+            if (entity_costs > 0u)
+            {
+                standardese_tool::count_allocations();
+                standardese::entity_profiler::get().enable(&standardese_tool::thread_allocations);
+            }
+
             try
             {
                 cppast::cpp_entity_index index;
 
                 std::clog << "parsing C++ files...\n";
                 auto parsed
-                    = standardese_tool::parse(compile_config, database, input, index, no_threads);
+                    = standardese_tool::parse(compile_config, database, input, index, no_threads,
+                                               *progress);
                 if (!parsed)
                     return 1;
 
                 std::clog << "parsing documentation comments...\n";
-                auto comments
-                    = standardese_tool::parse_comments(comment_config, parsed.value(), no_threads);
+                auto comments = standardese_tool::parse_comments(comment_config, parsed.value(),
+                                                                 blacklist, no_threads, *progress);
                 auto files
                     = standardese_tool::build_files(comments, index, std::move(parsed.value()),
-                                                    blacklist, no_threads);
+                                                    blacklist, no_threads, *progress);
 
                 std::clog << "generating documentation...\n";
                 auto docs = standardese_tool::generate(generation_config, synopsis_config, comments,
-                                                       index, linker, files, no_threads);
+                                                       index, linker, files, no_threads,
+                                                       *progress);
+                if (entity_costs > 0u)
+                    print_entity_costs(entity_costs);
+                if (!reports_links)
+                    // none of the formats resolves links while writing
+                    standardese_tool::check_links(docs, linker);
 
                 for (auto& format : formats)
                 {
@@ -475,7 +568,7 @@ int main(int argc, char* argv[])
                     if (!format_prefix.empty())
                         fs::create_directories(fs::path(format_prefix).parent_path());
                     standardese_tool::write_files(docs, format.first, std::move(format_prefix),
-                                                  format.second, no_threads);
+                                                  format.second, no_threads, *progress);
                 }
             }
             catch (std::exception& ex)
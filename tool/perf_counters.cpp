@@ -0,0 +1,105 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "perf_counters.hpp"
+
+#if defined(__linux__)
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define STANDARDESE_HAS_PERF_EVENT 1
+#else
+#define STANDARDESE_HAS_PERF_EVENT 0
+#endif
+
+using namespace standardese_tool;
+
+#if STANDARDESE_HAS_PERF_EVENT
+namespace
+{
+int open_counter(std::uint64_t config, int group_fd)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size   = sizeof(attr);
+    attr.type   = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    // only count our own code, this doesn't require special privileges
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    if (group_fd == -1)
+        // the group leader reads all counters at once,
+        // together with the times needed to detect multiplexing
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                           | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+} // namespace
+#endif
+
+const perf_counters& perf_counters::this_thread()
+{
+    static thread_local perf_counters counters;
+    return counters;
+}
+
+perf_counters::perf_counters()
+{
+    for (auto& fd : fds_)
+        fd = -1;
+
+#if STANDARDESE_HAS_PERF_EVENT
+    // the cycles are the group leader, so all counters are scheduled together
+    fds_[cycles] = open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (fds_[cycles] == -1)
+        return;
+    fds_[instructions]  = open_counter(PERF_COUNT_HW_INSTRUCTIONS, fds_[cycles]);
+    fds_[cache_misses]  = open_counter(PERF_COUNT_HW_CACHE_MISSES, fds_[cycles]);
+    fds_[branch_misses] = open_counter(PERF_COUNT_HW_BRANCH_MISSES, fds_[cycles]);
+#endif
+}
+
+perf_counters::~perf_counters()
+{
+#if STANDARDESE_HAS_PERF_EVENT
+    // members first, then the group leader
+    for (auto i = int(_count) - 1; i >= 0; --i)
+        if (fds_[i] != -1)
+            close(fds_[i]);
+#endif
+}
+
+perf_counters::values perf_counters::read() const
+{
+    std::uint64_t result[_count] = {};
+    values        v;
+#if STANDARDESE_HAS_PERF_EVENT
+    if (valid())
+    {
+        // number of counters, time enabled and time running,
+        // followed by the value of each counter in the group,
+        // counters that couldn't be opened are not part of it
+        std::uint64_t buffer[3 + _count];
+        if (::read(fds_[cycles], buffer, sizeof(buffer)) > 0)
+        {
+            v.time_enabled = buffer[1];
+            v.time_running = buffer[2];
+
+            auto cur = 0u;
+            for (auto i = 0; i != int(_count); ++i)
+                if (fds_[i] != -1 && cur < buffer[0])
+                    result[i] = buffer[3 + cur++];
+        }
+    }
+#endif
+
+    v.cycles        = result[cycles];
+    v.instructions  = result[instructions];
+    v.cache_misses  = result[cache_misses];
+    v.branch_misses = result[branch_misses];
+    return v;
+}
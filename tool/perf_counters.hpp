@@ -0,0 +1,121 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_TOOL_PERF_COUNTERS_HPP_INCLUDED
+#define STANDARDESE_TOOL_PERF_COUNTERS_HPP_INCLUDED
+
+#include <cstdint>
+
+namespace standardese_tool
+{
+/// The hardware performance counters of the calling thread.
+///
+/// They are read using `perf_event_open()`, so they're only available on Linux,
+/// and only if the kernel allows it.
+class perf_counters
+{
+public:
+    struct values
+    {
+        std::uint64_t cycles, instructions, cache_misses, branch_misses;
+        // nanoseconds the counters were enabled and actually counting,
+        // the kernel multiplexes them if there are not enough hardware counters
+        std::uint64_t time_enabled, time_running;
+
+        values()
+        : cycles(0u),
+          instructions(0u),
+          cache_misses(0u),
+          branch_misses(0u),
+          time_enabled(0u),
+          time_running(0u)
+        {}
+
+        /// \returns Whether or not the counters weren't counting the entire time.
+        bool multiplexed() const noexcept
+        {
+            return time_running < time_enabled;
+        }
+
+        /// \returns The counters extrapolated to the entire time they were enabled.
+        /// The times are kept, so it is still visible that they have been multiplexed.
+        values scaled() const noexcept
+        {
+            if (!multiplexed())
+                return *this;
+
+            auto factor = time_running == 0u ? 0. : double(time_enabled) / double(time_running);
+            auto scale  = [&](std::uint64_t value) {
+                return static_cast<std::uint64_t>(double(value) * factor + 0.5);
+            };
+
+            auto result          = *this;
+            result.cycles        = scale(cycles);
+            result.instructions  = scale(instructions);
+            result.cache_misses  = scale(cache_misses);
+            result.branch_misses = scale(branch_misses);
+            return result;
+        }
+
+        values& operator+=(const values& other) noexcept
+        {
+            cycles += other.cycles;
+            instructions += other.instructions;
+            cache_misses += other.cache_misses;
+            branch_misses += other.branch_misses;
+            time_enabled += other.time_enabled;
+            time_running += other.time_running;
+            return *this;
+        }
+
+        values& operator-=(const values& other) noexcept
+        {
+            cycles -= other.cycles;
+            instructions -= other.instructions;
+            cache_misses -= other.cache_misses;
+            branch_misses -= other.branch_misses;
+            time_enabled -= other.time_enabled;
+            time_running -= other.time_running;
+            return *this;
+        }
+    };
+
+    /// \returns The counters of the calling thread.
+    /// They are opened the first time the function is called on that thread,
+    /// and closed when it exits.
+    static const perf_counters& this_thread();
+
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    ~perf_counters();
+
+    /// \returns Whether or not the counters could be opened.
+    bool valid() const noexcept
+    {
+        return fds_[0] != -1;
+    }
+
+    /// \returns The raw values of the counters since they've been opened.
+    /// Counters that are not available stay zero.
+    /// \notes Differences between two values need to be [*values::scaled]() afterwards.
+    values read() const;
+
+private:
+    perf_counters();
+
+    enum counter
+    {
+        cycles,
+        instructions,
+        cache_misses,
+        branch_misses,
+        _count,
+    };
+
+    int fds_[_count];
+};
+} // namespace standardese_tool
+
+#endif // STANDARDESE_TOOL_PERF_COUNTERS_HPP_INCLUDED
@@ -0,0 +1,468 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "progress.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#define STANDARDESE_ISATTY(Fd) _isatty(Fd)
+#else
+#include <unistd.h>
+#define STANDARDESE_ISATTY(Fd) isatty(Fd)
+#endif
+
+using namespace standardese_tool;
+
+namespace
+{
+constexpr auto max_reported_jobs = 3u;
+
+double to_seconds(progress_reporter::clock::duration d)
+{
+    return std::chrono::duration<double>(d).count();
+}
+
+std::string timing_key(const std::string& phase, const std::string& file)
+{
+    return phase + '\t' + file;
+}
+
+std::string format_duration(double seconds)
+{
+    std::ostringstream str;
+    auto               total = static_cast<unsigned long>(seconds + 0.5);
+    if (total >= 60u)
+        str << total / 60u << 'm' << std::setw(2) << std::setfill('0') << total % 60u << 's';
+    else
+        str << std::fixed << std::setprecision(1) << seconds << 's';
+    return str.str();
+}
+
+std::string json_string(const std::string& str)
+{
+    std::string result = "\"";
+    for (auto c : str)
+        if (c == '"' || c == '\\')
+            result += std::string("\\") + c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+            result += buffer;
+        }
+        else
+            result += c;
+    result += '"';
+    return result;
+}
+
+perf_counters::values read_counters()
+{
+    return perf_counters::this_thread().read();
+}
+
+perf_counters::values counters_since(const perf_counters::values& start)
+{
+    auto result = read_counters();
+    result -= start;
+    return result.scaled();
+}
+
+std::string json_counters(const perf_counters::values& v)
+{
+    std::ostringstream str;
+    str << "\"cycles\":" << v.cycles << ",\"instructions\":" << v.instructions
+        << ",\"cache_misses\":" << v.cache_misses << ",\"branch_misses\":" << v.branch_misses
+        << ",\"time_enabled\":" << v.time_enabled << ",\"time_running\":" << v.time_running;
+    return str.str();
+}
+
+void write_counters(std::ostream& out, const perf_counters::values& v)
+{
+    out << v.cycles << " cycles, " << v.instructions << " instructions";
+    if (v.cycles > 0u)
+        out << " (" << std::fixed << std::setprecision(2)
+            << static_cast<double>(v.instructions) / static_cast<double>(v.cycles) << " IPC)";
+    out << ", " << v.cache_misses << " cache misses, " << v.branch_misses << " branch misses";
+    if (v.multiplexed())
+        // the values are estimates then, so they shouldn't be compared to exact ones
+        out << " (scaled, counting " << std::fixed << std::setprecision(0)
+            << 100. * static_cast<double>(v.time_running) / static_cast<double>(v.time_enabled)
+            << "% of the time)";
+}
+} // namespace
+
+progress_reporter::output_mode progress_reporter::default_output_mode()
+{
+    return STANDARDESE_ISATTY(2) ? output_mode::status_line : output_mode::json;
+}
+
+progress_reporter::progress_reporter(output_mode mode, std::string timings_file,
+                                     unsigned no_threads, bool record_perf_counters)
+: total_jobs_(0u),
+  finished_jobs_(0u),
+  finished_entities_(0u),
+  finished_seconds_(0.),
+  next_id_(0u),
+  finished_phases_(0u),
+  timings_file_(std::move(timings_file)),
+  logger_(*this),
+  no_threads_(std::max(no_threads, 1u)),
+  mode_(mode),
+  perf_(record_perf_counters),
+  done_(false)
+{
+    if (perf_ && !perf_counters::this_thread().valid())
+    {
+        std::cerr << "warning: hardware performance counters are not available\n";
+        perf_ = false;
+    }
+
+    if (!enabled())
+        return;
+
+    read_timings();
+    if (reports_progress())
+        thread_ = std::thread([this] { run(); });
+}
+
+progress_reporter::~progress_reporter()
+{
+    if (!enabled())
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        finish_phase(lock);
+        done_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable())
+        thread_.join();
+
+    write_timings();
+}
+
+void progress_reporter::begin_phase(std::string name, std::size_t no_jobs)
+{
+    if (!enabled())
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    finish_phase(lock);
+
+    phase_             = std::move(name);
+    total_jobs_        = no_jobs;
+    finished_jobs_     = 0u;
+    finished_entities_ = 0u;
+    finished_seconds_  = 0.;
+    phase_start_       = clock::now();
+
+    if (perf_)
+    {
+        thread_indices_.clear();
+        thread_indices_.emplace(std::this_thread::get_id(), 0u);
+        thread_counters_.assign(1u, perf_counters::values());
+        phase_start_counters_ = read_counters();
+    }
+}
+
+void progress_reporter::end_phase()
+{
+    if (!enabled())
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    finish_phase(lock);
+}
+
+progress_reporter::job progress_reporter::start_job(const std::string& file,
+                                                    std::size_t        entities)
+{
+    if (!enabled())
+        return job(nullptr, 0u, 0u);
+
+    // read the counters outside of the lock, so waiting for it isn't counted
+    auto counters = perf_ ? read_counters() : perf_counters::values();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto                        id = next_id_++;
+    running_.emplace(id, running_job{file, clock::now(), counters});
+    return job(this, id, entities);
+}
+
+void progress_reporter::finish_job(std::size_t id, std::size_t entities)
+{
+    auto counters = perf_ ? read_counters() : perf_counters::values();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto iter = running_.find(id);
+    if (iter == running_.end())
+        return;
+
+    if (perf_)
+    {
+        // jobs are finished on the thread that started them
+        counters -= iter->second.counters;
+        counters = counters.scaled();
+
+        auto index = thread_indices_.emplace(std::this_thread::get_id(), thread_counters_.size())
+                         .first->second;
+        if (index == thread_counters_.size())
+            thread_counters_.emplace_back();
+        thread_counters_[index] += counters;
+    }
+
+    auto seconds = to_seconds(clock::now() - iter->second.start);
+    timings_[timing_key(phase_, iter->second.file)] = seconds;
+
+    ++finished_jobs_;
+    finished_seconds_ += seconds;
+    finished_entities_ += entities;
+
+    running_.erase(iter);
+}
+
+bool progress_reporter::status_logger::do_log(const char*               source,
+                                              const cppast::diagnostic& d) const
+{
+    // the status line doesn't end with a newline, so clear it before the diagnostic is printed,
+    // it is written again on the next update
+    std::lock_guard<std::mutex> output_lock(reporter_->output_mutex_);
+    if (reporter_->mode_ == output_mode::status_line)
+        std::clog << "\r\033[K" << std::flush;
+    return cppast::default_logger()->log(source, d);
+}
+
+void progress_reporter::run()
+{
+    auto interval = mode_ == output_mode::json ? std::chrono::milliseconds(1000)
+                                               : std::chrono::milliseconds(250);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!done_)
+    {
+        cv_.wait_for(lock, interval);
+        if (done_ || phase_.empty())
+            continue;
+
+        auto status = get_status(clock::now());
+        auto phase  = finished_phases_.load();
+
+        // don't block the jobs while writing to the terminal
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> output_lock(output_mutex_);
+            if (phase == finished_phases_.load())
+                (mode_ == output_mode::json ? std::cout : std::clog) << status << std::flush;
+        }
+        lock.lock();
+    }
+}
+
+std::string progress_reporter::get_status(clock::time_point now) const
+{
+    auto elapsed = to_seconds(now - phase_start_);
+    auto rate    = elapsed > 0. ? static_cast<double>(finished_entities_) / elapsed : 0.;
+    auto eta     = estimate_remaining(now);
+
+    std::vector<const running_job*> slowest;
+    for (auto& pair : running_)
+        slowest.push_back(&pair.second);
+    std::sort(slowest.begin(), slowest.end(),
+              [](const running_job* a, const running_job* b) { return a->start < b->start; });
+    if (slowest.size() > max_reported_jobs)
+        slowest.resize(max_reported_jobs);
+
+    std::ostringstream str;
+    if (mode_ == output_mode::json)
+    {
+        str << "{\"phase\":" << json_string(phase_) << ",\"finished\":" << finished_jobs_
+            << ",\"total\":" << total_jobs_ << ",\"elapsed\":" << elapsed
+            << ",\"entities_per_second\":" << rate << ",\"eta\":";
+        if (eta < 0.)
+            str << "null";
+        else
+            str << eta;
+        str << ",\"running\":[";
+
+        auto first = true;
+        for (auto job : slowest)
+        {
+            if (!first)
+                str << ',';
+            first = false;
+            str << "{\"file\":" << json_string(job->file)
+                << ",\"elapsed\":" << to_seconds(now - job->start) << '}';
+        }
+        str << "]}\n";
+    }
+    else
+    {
+        str << "\r\033[K[" << phase_ << "] " << finished_jobs_ << '/' << total_jobs_ << " files, "
+            << std::fixed << std::setprecision(0) << rate << " entities/s";
+        if (eta >= 0.)
+            str << ", ETA " << format_duration(eta);
+        for (auto job : slowest)
+            str << " | " << job->file << " (" << format_duration(to_seconds(now - job->start))
+                << ')';
+    }
+
+    return str.str();
+}
+
+void progress_reporter::finish_phase(std::unique_lock<std::mutex>&)
+{
+    if (phase_.empty())
+        return;
+
+    phases_[phase_] = to_seconds(clock::now() - phase_start_);
+    if (perf_)
+        // the main thread is only waiting for the jobs most of the time,
+        // but it also does the work in between
+        thread_counters_[0u] += counters_since(phase_start_counters_);
+
+    std::lock_guard<std::mutex> output_lock(output_mutex_);
+    ++finished_phases_;
+    if (mode_ == output_mode::status_line)
+    {
+        // clear the status line, so the following output starts at the beginning of the line
+        std::clog << "\r\033[K";
+        if (perf_)
+            print_counters(std::clog);
+        std::clog << std::flush;
+    }
+    else if (mode_ == output_mode::json)
+    {
+        std::cout << "{\"phase\":" << json_string(phase_) << ",\"finished\":" << finished_jobs_
+                  << ",\"total\":" << total_jobs_ << ",\"elapsed\":" << phases_[phase_];
+        if (perf_)
+        {
+            perf_counters::values total;
+            for (auto& counters : thread_counters_)
+                total += counters;
+
+            std::cout << ",\"perf_counters\":{" << json_counters(total) << ",\"threads\":[";
+            for (auto i = 0u; i != thread_counters_.size(); ++i)
+                std::cout << (i == 0u ? "" : ",") << "{\"thread\":" << i << ','
+                          << json_counters(thread_counters_[i]) << '}';
+            std::cout << "]}";
+        }
+        std::cout << "}\n" << std::flush;
+    }
+    else if (perf_)
+        print_counters(std::clog);
+
+    phase_.clear();
+    running_.clear();
+}
+
+void progress_reporter::print_counters(std::ostream& out) const
+{
+    perf_counters::values total;
+    for (auto& counters : thread_counters_)
+        total += counters;
+
+    std::ostringstream str;
+    str << '[' << phase_ << "] ";
+    write_counters(str, total);
+    str << '\n';
+    for (auto i = 0u; i != thread_counters_.size(); ++i)
+    {
+        str << "    " << (i == 0u ? std::string("main thread") : "thread " + std::to_string(i))
+            << ": ";
+        write_counters(str, thread_counters_[i]);
+        str << '\n';
+    }
+
+    out << str.str();
+}
+
+double progress_reporter::estimate_remaining(clock::time_point now) const
+{
+    // average duration of a job in the current phase, falling back to the previous run
+    auto average = -1.;
+    if (finished_jobs_ > 0u)
+        average = finished_seconds_ / static_cast<double>(finished_jobs_);
+    else
+    {
+        auto previous = previous_phases_.find(phase_);
+        if (previous != previous_phases_.end() && total_jobs_ > 0u)
+            average = previous->second * no_threads_ / static_cast<double>(total_jobs_);
+    }
+
+    auto total = 0.;
+    for (auto& pair : running_)
+    {
+        auto previous = previous_timings_.find(timing_key(phase_, pair.second.file));
+        auto expected = previous != previous_timings_.end() ? previous->second : average;
+        if (expected < 0.)
+            return -1.;
+        total += std::max(expected - to_seconds(now - pair.second.start), 0.);
+    }
+
+    auto pending = total_jobs_ - std::min(total_jobs_, finished_jobs_ + running_.size());
+    if (pending > 0u)
+    {
+        if (average < 0.)
+            return -1.;
+        total += static_cast<double>(pending) * average;
+    }
+    total /= no_threads_;
+
+    // phases that haven't run yet, as far as the previous run knows
+    for (auto& pair : previous_phases_)
+        if (pair.first != phase_ && phases_.count(pair.first) == 0u)
+            total += pair.second;
+
+    return total;
+}
+
+// The timings file consists of lines `<phase>\t<file>\t<seconds>`,
+// where an empty file stores the duration of the entire phase.
+void progress_reporter::read_timings()
+{
+    if (timings_file_.empty())
+        return;
+
+    std::ifstream file(timings_file_);
+    std::string   line;
+    while (std::getline(file, line))
+    {
+        auto first  = line.find('\t');
+        auto second = first == std::string::npos ? first : line.find('\t', first + 1u);
+        if (second == std::string::npos)
+            continue;
+
+        auto phase   = line.substr(0u, first);
+        auto name    = line.substr(first + 1u, second - first - 1u);
+        auto seconds = std::strtod(line.c_str() + second + 1u, nullptr);
+        if (name.empty())
+            previous_phases_[phase] = seconds;
+        else
+            previous_timings_[timing_key(phase, name)] = seconds;
+    }
+}
+
+void progress_reporter::write_timings() const
+{
+    if (timings_file_.empty())
+        return;
+
+    std::ofstream file(timings_file_);
+    for (auto& pair : phases_)
+        file << pair.first << "\t\t" << pair.second << '\n';
+    for (auto& pair : timings_)
+        file << pair.first << '\t' << pair.second << '\n';
+}
@@ -0,0 +1,191 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_TOOL_PROGRESS_HPP_INCLUDED
+#define STANDARDESE_TOOL_PROGRESS_HPP_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cppast/diagnostic_logger.hpp>
+
+#include "perf_counters.hpp"
+
+namespace standardese_tool
+{
+/// Reports the progress of the individual phases.
+///
+/// It keeps track of the jobs of the current phase and periodically prints a status line to stderr,
+/// or a JSON line to stdout when stderr is not a terminal.
+/// If a timings file is given, the durations of the jobs are read from and written to it,
+/// so the ETA can be estimated using the previous run.
+/// If enabled, the hardware performance counters of each job are recorded as well,
+/// and reported per thread at the end of each phase.
+class progress_reporter
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    enum class output_mode
+    {
+        none,
+        status_line,
+        json,
+    };
+
+    /// \returns The output mode that should be used for the current stderr.
+    static output_mode default_output_mode();
+
+    /// \effects Creates a reporter that prints nothing.
+    progress_reporter() : progress_reporter(output_mode::none, "", 1u, false) {}
+
+    progress_reporter(output_mode mode, std::string timings_file, unsigned no_threads,
+                      bool record_perf_counters);
+
+    progress_reporter(const progress_reporter&) = delete;
+    progress_reporter& operator=(const progress_reporter&) = delete;
+
+    /// \effects Finishes the current phase and writes the timings file.
+    ~progress_reporter();
+
+    bool enabled() const noexcept
+    {
+        return mode_ != output_mode::none || perf_;
+    }
+
+    /// \returns Whether or not the progress itself is reported.
+    bool reports_progress() const noexcept
+    {
+        return mode_ != output_mode::none;
+    }
+
+    /// \effects Starts a new phase consisting of `no_jobs` jobs.
+    /// The previous phase is finished.
+    void begin_phase(std::string name, std::size_t no_jobs);
+
+    /// \effects Finishes the current phase.
+    void end_phase();
+
+    /// A running job, finishes it on destruction.
+    class job
+    {
+    public:
+        job(job&& other) noexcept
+        : reporter_(other.reporter_), id_(other.id_), entities_(other.entities_)
+        {
+            other.reporter_ = nullptr;
+        }
+
+        ~job()
+        {
+            if (reporter_)
+                reporter_->finish_job(id_, entities_);
+        }
+
+        job& operator=(job&&) = delete;
+
+        /// \effects Sets the number of entities processed by the job,
+        /// for jobs that only know it once they're running.
+        void set_entity_count(std::size_t count) noexcept
+        {
+            entities_ = count;
+        }
+
+    private:
+        job(progress_reporter* reporter, std::size_t id, std::size_t entities)
+        : reporter_(reporter), id_(id), entities_(entities)
+        {}
+
+        progress_reporter* reporter_;
+        std::size_t        id_, entities_;
+
+        friend progress_reporter;
+    };
+
+    /// \returns A job of the current phase processing the given file.
+    /// The number of entities in the file is its weight for the entities per second.
+    job start_job(const std::string& file, std::size_t entities = 0u);
+
+    /// \returns A logger forwarding to the default logger,
+    /// that clears the status line before a diagnostic is printed.
+    /// It must be used for all diagnostics issued while a phase is running.
+    const cppast::diagnostic_logger& logger() const noexcept
+    {
+        return logger_;
+    }
+
+private:
+    class status_logger : public cppast::diagnostic_logger
+    {
+    public:
+        explicit status_logger(progress_reporter& reporter) : reporter_(&reporter) {}
+
+    private:
+        bool do_log(const char* source, const cppast::diagnostic& d) const override;
+
+        progress_reporter* reporter_;
+    };
+
+    struct running_job
+    {
+        std::string           file;
+        clock::time_point     start;
+        perf_counters::values counters;
+    };
+
+    void finish_job(std::size_t id, std::size_t entities);
+
+    void        run();
+    std::string get_status(clock::time_point now) const;
+    void finish_phase(std::unique_lock<std::mutex>& lock);
+    void print_counters(std::ostream& out) const;
+
+    double estimate_remaining(clock::time_point now) const;
+
+    void read_timings();
+    void write_timings() const;
+
+    std::mutex              mutex_;
+    std::condition_variable cv_;
+    std::thread             thread_;
+
+    std::string phase_;
+    std::size_t total_jobs_, finished_jobs_, finished_entities_;
+    double      finished_seconds_;
+
+    clock::time_point                  phase_start_;
+    std::map<std::size_t, running_job> running_;
+    std::size_t                        next_id_;
+
+    // locked while writing a status or diagnostic, after mutex_ if both are needed
+    std::mutex output_mutex_;
+    // incremented with output_mutex_ locked, a status of a finished phase isn't written
+    std::atomic<std::size_t> finished_phases_;
+
+    // phase + '\t' + file -> seconds
+    std::map<std::string, double> previous_timings_, timings_;
+    std::map<std::string, double> previous_phases_, phases_;
+
+    // counters of the current phase per thread, the main thread has index 0
+    perf_counters::values                   phase_start_counters_;
+    std::map<std::thread::id, std::size_t> thread_indices_;
+    std::vector<perf_counters::values>      thread_counters_;
+
+    std::string   timings_file_;
+    status_logger logger_;
+    unsigned      no_threads_;
+    output_mode   mode_;
+    bool          perf_, done_;
+};
+} // namespace standardese_tool
+
+#endif // STANDARDESE_TOOL_PROGRESS_HPP_INCLUDED